@@ -0,0 +1,49 @@
+#ifndef GPMCompressFrame_h
+#define GPMCompressFrame_h
+
+#include <cstddef>
+
+namespace gpm {
+
+// Frame : ${gpm_compress}<uncompressed byte length>:<base64 raw deflate>
+// Data that starts with the header but is sent as is becomes ${gpm_compress}:<data>, so it is never read as a frame.
+// Same header as GPM_COMMUNICATOR_COMPRESS_HEADER and CommunicatorCompressor.HEADER.
+const char COMPRESS_HEADER[] = "${gpm_compress}";
+const size_t COMPRESS_HEADER_LENGTH = sizeof(COMPRESS_HEADER) - 1;
+const char COMPRESS_LENGTH_DELIMITER = ':';
+
+inline size_t base64Length(size_t length) {
+    return (length + 2) / 3 * 4;
+}
+
+inline size_t decimalLength(size_t value) {
+    size_t length = 1;
+    while(value >= 10) {
+        value /= 10;
+        length++;
+    }
+    return length;
+}
+
+// Characters of the frame for sourceLength bytes deflated to compressedLength bytes. The frame is ASCII, so also its bytes.
+inline size_t compressedFrameLength(size_t sourceLength, size_t compressedLength) {
+    return COMPRESS_HEADER_LENGTH + decimalLength(sourceLength) + 1 + base64Length(compressedLength);
+}
+
+// Largest deflate output whose frame is still shorter than the source, 0 when no output can be.
+// Used as the deflate buffer size, so output that would not pay for its base64 expansion is never kept.
+inline size_t maxCompressedLength(size_t sourceLength) {
+    size_t overhead = COMPRESS_HEADER_LENGTH + decimalLength(sourceLength) + 1;
+    if(sourceLength <= overhead + 4) {
+        return 0;
+    }
+    return (sourceLength - overhead - 1) / 4 * 3;
+}
+
+inline bool isCompressedFrameSmaller(size_t sourceLength, size_t compressedLength) {
+    return compressedLength > 0 && compressedFrameLength(sourceLength, compressedLength) < sourceLength;
+}
+
+}
+
+#endif /* GPMCompressFrame_h */
@@ -0,0 +1,169 @@
+#ifndef GPMDispatchLanes_h
+#define GPMDispatchLanes_h
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+namespace gpm {
+
+enum DispatchPriority {
+    DispatchPriorityBulk = 0,
+    DispatchPriorityControl = 1
+};
+
+// Control and bulk FIFO lanes with per-session and per-domain epochs.
+// A bulk message is served after at most controlBurstLimit consecutive control messages.
+// Ending a session advances its epoch in O(1); bulk messages queued under an older epoch are dropped when dequeued.
+// Cancelling a domain does the same for every session of the domain, whatever their keys.
+// Not thread-safe, the owner serializes access.
+template <typename T>
+class DispatchLanes {
+public:
+    static const size_t DEFAULT_CONTROL_BURST_LIMIT = 8;
+
+    explicit DispatchLanes(size_t controlBurstLimit = DEFAULT_CONTROL_BURST_LIMIT)
+        : _controlBurstLimit(controlBurstLimit), _controlStreak(0), _droppedCount(0) {
+    }
+
+    void push(T value, const std::string& domain, const std::string& session, DispatchPriority priority, bool endsSession) {
+        Entry entry;
+        entry.value = std::move(value);
+        entry.domain = domain;
+        entry.session = session;
+        entry.epoch = epochWithKey(_epochMap, session);
+        entry.domainEpoch = epochWithKey(_domainEpochMap, domain);
+
+        if(endsSession == true) {
+            _epochMap[session]++;
+        }
+
+        if(priority == DispatchPriorityControl) {
+            _controlLane.push_back(std::move(entry));
+        } else {
+            _bulkLane.push_back(std::move(entry));
+        }
+    }
+
+    bool pop(T& value) {
+        while(_controlLane.empty() == false || _bulkLane.empty() == false) {
+            bool takeBulk = _bulkLane.empty() == false && (_controlLane.empty() == true || _controlStreak >= _controlBurstLimit);
+
+            if(takeBulk == true) {
+                Entry entry = std::move(_bulkLane.front());
+                _bulkLane.pop_front();
+                _controlStreak = 0;
+
+                if(isStale(entry) == true) {
+                    _droppedCount++;
+                    continue;
+                }
+                value = std::move(entry.value);
+                return true;
+            }
+
+            value = std::move(_controlLane.front().value);
+            _controlLane.pop_front();
+            _controlStreak++;
+            return true;
+        }
+
+        _controlStreak = 0;
+        return false;
+    }
+
+    // Next message of one domain by the same lane rules. Messages of other domains keep their place.
+    bool pop(T& value, const std::string& domain) {
+        for(;;) {
+            typename std::deque<Entry>::iterator control = findDomain(_controlLane, domain);
+            typename std::deque<Entry>::iterator bulk = findDomain(_bulkLane, domain);
+            bool hasControl = control != _controlLane.end();
+            bool hasBulk = bulk != _bulkLane.end();
+
+            if(hasControl == false && hasBulk == false) {
+                return false;
+            }
+
+            if(hasBulk == true && (hasControl == false || _controlStreak >= _controlBurstLimit)) {
+                Entry entry = std::move(*bulk);
+                _bulkLane.erase(bulk);
+                _controlStreak = 0;
+
+                if(isStale(entry) == true) {
+                    _droppedCount++;
+                    continue;
+                }
+                value = std::move(entry.value);
+                return true;
+            }
+
+            value = std::move(control->value);
+            _controlLane.erase(control);
+            _controlStreak++;
+            return true;
+        }
+    }
+
+    void cancelSession(const std::string& session) {
+        _epochMap[session]++;
+    }
+
+    void cancelDomain(const std::string& domain) {
+        _domainEpochMap[domain]++;
+    }
+
+    size_t size() const {
+        return _controlLane.size() + _bulkLane.size();
+    }
+
+    bool empty() const {
+        return _controlLane.empty() == true && _bulkLane.empty() == true;
+    }
+
+    // Stale bulk messages dropped so far.
+    size_t droppedCount() const {
+        return _droppedCount;
+    }
+
+private:
+    struct Entry {
+        T value;
+        std::string domain;
+        std::string session;
+        uint64_t epoch;
+        uint64_t domainEpoch;
+    };
+
+    static uint64_t epochWithKey(const std::unordered_map<std::string, uint64_t>& epochMap, const std::string& key) {
+        std::unordered_map<std::string, uint64_t>::const_iterator it = epochMap.find(key);
+        return (it != epochMap.end()) ? it->second : 0;
+    }
+
+    static typename std::deque<Entry>::iterator findDomain(std::deque<Entry>& lane, const std::string& domain) {
+        typename std::deque<Entry>::iterator it = lane.begin();
+        while(it != lane.end() && it->domain != domain) {
+            ++it;
+        }
+        return it;
+    }
+
+    bool isStale(const Entry& entry) const {
+        return entry.epoch != epochWithKey(_epochMap, entry.session) ||
+               entry.domainEpoch != epochWithKey(_domainEpochMap, entry.domain);
+    }
+
+    std::deque<Entry> _controlLane;
+    std::deque<Entry> _bulkLane;
+    std::unordered_map<std::string, uint64_t> _epochMap;
+    std::unordered_map<std::string, uint64_t> _domainEpochMap;
+    size_t _controlBurstLimit;
+    size_t _controlStreak;
+    size_t _droppedCount;
+};
+
+}
+
+#endif /* GPMDispatchLanes_h */
@@ -0,0 +1,123 @@
+#ifndef GPMPluginLoader_h
+#define GPMPluginLoader_h
+
+#include "GPMSnapshotCell.h"
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace gpm {
+
+// Creates the plugins of a domain from a table built at link time, on the first lookup of the domain that misses.
+// The table is scanned once per domain. Domains without a plugin are remembered too, checked without locking.
+// A thread that misses while another creates the domain's plugins waits for it; a lookup from the creating thread,
+// as from a plugin's init, returns at once. Plugins are created without the lock, so an init can look up other domains.
+template <typename Entry>
+class PluginLoader {
+public:
+    PluginLoader(const Entry* entries, size_t entryCount)
+        : _entries(entries), _entryCount(entryCount), _triedDomains(new DomainSet()) {
+    }
+
+    const Entry* entries() const {
+        return _entries;
+    }
+
+    size_t entryCount() const {
+        return _entryCount;
+    }
+
+    // matches(entry) selects the domain's entries, create(entry) returns true when it created a plugin.
+    // Returns true when a plugin may have been created since the caller looked, so the caller should look again.
+    template <typename Matches, typename Create>
+    bool load(const std::string& domain, Matches matches, Create create) {
+        if(isTried(domain) == true) {
+            return false;
+        }
+
+        // Held while this thread creates the domain's plugins. Taken before _mutex, as waiters never hold both.
+        std::shared_ptr<std::mutex> created = std::make_shared<std::mutex>();
+        std::unique_lock<std::mutex> creating(*created);
+
+        std::unique_lock<std::mutex> lock(_mutex);
+        typename LoadingMap::iterator loading = _loadingDomains.find(domain);
+        if(loading != _loadingDomains.end()) {
+            if(loading->second.thread == std::this_thread::get_id()) {
+                // A lookup from the plugin's own init. Its receiver is not added yet.
+                return false;
+            }
+            // The creating thread holds the domain's mutex until its plugins are created.
+            std::shared_ptr<std::mutex> other = loading->second.created;
+            lock.unlock();
+            creating.unlock();
+            std::lock_guard<std::mutex> wait(*other);
+            return true;
+        }
+
+        if(isTried(domain) == true) {
+            return false;
+        }
+        Loading& entry = _loadingDomains[domain];
+        entry.thread = std::this_thread::get_id();
+        entry.created = created;
+        lock.unlock();
+
+        size_t createdCount = 0;
+        for(size_t index = 0; index < _entryCount; index++) {
+            if(matches(_entries[index]) == true && create(_entries[index]) == true) {
+                createdCount++;
+            }
+        }
+
+        lock.lock();
+        _triedDomains.update([&](const DomainSet* current) -> const DomainSet* {
+            DomainSet* next = new DomainSet(*current);
+            next->insert(domain);
+            return next;
+        });
+        _loadingDomains.erase(domain);
+        lock.unlock();
+        creating.unlock();
+
+        return createdCount > 0;
+    }
+
+    bool isTried(const std::string& domain) const {
+        typename DomainCell::ReadGuard guard(_triedDomains);
+        return guard.get()->count(domain) > 0;
+    }
+
+    void reclaim() {
+        _triedDomains.reclaim();
+    }
+
+private:
+    PluginLoader(const PluginLoader&);
+    PluginLoader& operator=(const PluginLoader&);
+
+    typedef std::unordered_set<std::string> DomainSet;
+    typedef SnapshotCell<const DomainSet> DomainCell;
+
+    struct Loading {
+        std::thread::id thread;
+        std::shared_ptr<std::mutex> created;
+    };
+
+    typedef std::unordered_map<std::string, Loading> LoadingMap;
+
+    const Entry* const _entries;
+    const size_t _entryCount;
+    DomainCell _triedDomains;
+    // Guards _loadingDomains, the domains whose plugins a thread is creating.
+    std::mutex _mutex;
+    LoadingMap _loadingDomains;
+};
+
+}
+
+#endif /* GPMPluginLoader_h */
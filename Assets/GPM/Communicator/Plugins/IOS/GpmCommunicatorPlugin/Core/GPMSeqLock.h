@@ -0,0 +1,80 @@
+#ifndef GPMSeqLock_h
+#define GPMSeqLock_h
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <type_traits>
+
+namespace gpm {
+
+// Seqlock over a small plain struct. The writer makes the sequence odd while it updates the words,
+// readers retry until they see the same even sequence before and after copying them.
+// Readers never block, so a value can be read from any thread while the owner publishes it.
+// Ordering comes from the word accesses themselves rather than fences: a reader that acquires a word the writer released
+// also sees the odd sequence stored before it, so its second sequence load fails. ThreadSanitizer follows this directly.
+template <typename T>
+class SeqLock {
+    static_assert(std::is_trivially_copyable<T>::value, "SeqLock holds plain structs only");
+    static_assert(sizeof(T) % sizeof(uint32_t) == 0, "SeqLock copies whole 32-bit words");
+
+public:
+    SeqLock() : _sequence(0) {
+        storeWords(T(), std::memory_order_relaxed);
+    }
+
+    explicit SeqLock(const T& value) : _sequence(0) {
+        storeWords(value, std::memory_order_relaxed);
+    }
+
+    void store(const T& value) {
+        std::lock_guard<std::mutex> lock(_writeMutex);
+
+        uint32_t sequence = _sequence.load(std::memory_order_relaxed);
+        _sequence.store(sequence + 1, std::memory_order_relaxed);
+
+        storeWords(value, std::memory_order_release);
+
+        _sequence.store(sequence + 2, std::memory_order_release);
+    }
+
+    T load() const {
+        uint32_t words[WORD_COUNT];
+        uint32_t sequence;
+
+        do {
+            sequence = _sequence.load(std::memory_order_acquire);
+            for(size_t index = 0; index < WORD_COUNT; index++) {
+                words[index] = _words[index].load(std::memory_order_acquire);
+            }
+        } while((sequence & 1) != 0 || sequence != _sequence.load(std::memory_order_relaxed));
+
+        T value;
+        std::memcpy(&value, words, sizeof(T));
+        return value;
+    }
+
+private:
+    SeqLock(const SeqLock&);
+    SeqLock& operator=(const SeqLock&);
+
+    static const size_t WORD_COUNT = sizeof(T) / sizeof(uint32_t);
+
+    void storeWords(const T& value, std::memory_order order) {
+        uint32_t words[WORD_COUNT];
+        std::memcpy(words, &value, sizeof(T));
+        for(size_t index = 0; index < WORD_COUNT; index++) {
+            _words[index].store(words[index], order);
+        }
+    }
+
+    std::atomic<uint32_t> _sequence;
+    std::atomic<uint32_t> _words[WORD_COUNT];
+    std::mutex _writeMutex;
+};
+
+}
+
+#endif /* GPMSeqLock_h */
@@ -0,0 +1,181 @@
+#ifndef GPMSnapshotCell_h
+#define GPMSnapshotCell_h
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace gpm {
+
+// Readers count themselves in stripes so that threads do not write to the same cache line.
+// 128 bytes covers the cache line of Apple silicon, and twice the 64 bytes of other cores.
+const size_t SNAPSHOT_READER_STRIPE_COUNT = 16;
+const size_t SNAPSHOT_READER_STRIPE_LENGTH = 128;
+
+// The stripe of the calling thread, assigned round robin on its first read.
+inline size_t snapshotReaderStripe() {
+    static std::atomic<size_t> nextStripe(0);
+    static thread_local size_t stripe = nextStripe.fetch_add(1, std::memory_order_relaxed) % SNAPSHOT_READER_STRIPE_COUNT;
+    return stripe;
+}
+
+// Read-mostly pointer cell. Readers never lock; writers replace the whole snapshot under a mutex.
+// A replaced snapshot is retired with the epoch it was replaced in and deleted once no reader can still hold it:
+// readers count themselves in one of two slots by epoch parity, the epoch only advances when the other slot is empty
+// in every stripe, so a snapshot retired in epoch e is unreachable when the epoch reaches e + 2.
+template <typename T, typename Deleter = std::default_delete<T> >
+class SnapshotCell {
+public:
+    // Keeps the snapshot read through it alive until destroyed. Hold it only for the lookup.
+    class ReadGuard {
+    public:
+        explicit ReadGuard(const SnapshotCell& cell) : _cell(cell) {
+            ReaderStripe& stripe = _cell._readerStripes[snapshotReaderStripe()];
+            for(;;) {
+                uint64_t epoch = _cell._epoch.load(std::memory_order_seq_cst);
+                _count = &stripe.counts[epoch & 1];
+                _count->fetch_add(1, std::memory_order_seq_cst);
+                if(_cell._epoch.load(std::memory_order_seq_cst) == epoch) {
+                    break;
+                }
+                _count->fetch_sub(1, std::memory_order_release);
+            }
+            _value = _cell._current.load(std::memory_order_acquire);
+        }
+
+        ~ReadGuard() {
+            _count->fetch_sub(1, std::memory_order_release);
+        }
+
+        T* get() const {
+            return _value;
+        }
+
+    private:
+        ReadGuard(const ReadGuard&);
+        ReadGuard& operator=(const ReadGuard&);
+
+        const SnapshotCell& _cell;
+        std::atomic<size_t>* _count;
+        T* _value;
+    };
+
+    explicit SnapshotCell(T* initial, Deleter deleter = Deleter())
+        : _current(initial), _epoch(0), _retiredCount(0), _deleter(deleter) {
+        for(size_t index = 0; index < SNAPSHOT_READER_STRIPE_COUNT; index++) {
+            _readerStripes[index].counts[0].store(0, std::memory_order_relaxed);
+            _readerStripes[index].counts[1].store(0, std::memory_order_relaxed);
+        }
+    }
+
+    // No reader may be left.
+    ~SnapshotCell() {
+        for(size_t index = 0; index < _retired.size(); index++) {
+            _deleter(_retired[index].value);
+        }
+        _deleter(_current.load(std::memory_order_relaxed));
+    }
+
+    // makeNext receives the current snapshot and returns its replacement, or nullptr to keep it.
+    // Writers are serialized, so makeNext can copy and modify without losing a concurrent update.
+    template <typename MakeNext>
+    bool update(MakeNext makeNext) {
+        std::lock_guard<std::mutex> lock(_writeMutex);
+
+        T* next = makeNext(_current.load(std::memory_order_relaxed));
+        if(next == nullptr) {
+            return false;
+        }
+
+        Retired retired;
+        retired.value = _current.exchange(next, std::memory_order_acq_rel);
+        retired.epoch = _epoch.load(std::memory_order_relaxed);
+        _retired.push_back(retired);
+        _retiredCount.store(_retired.size(), std::memory_order_release);
+
+        advanceEpoch();
+        collect();
+        return true;
+    }
+
+    // Call at a quiescent point, for example when a dispatch pass ends, to delete what the last update left.
+    // Returns at once while a writer holds the cell.
+    size_t reclaim() {
+        if(_retiredCount.load(std::memory_order_acquire) == 0) {
+            return 0;
+        }
+
+        std::unique_lock<std::mutex> lock(_writeMutex, std::try_to_lock);
+        if(lock.owns_lock() == false) {
+            return 0;
+        }
+
+        advanceEpoch();
+        advanceEpoch();
+        return collect();
+    }
+
+    size_t retiredCount() const {
+        return _retiredCount.load(std::memory_order_acquire);
+    }
+
+private:
+    SnapshotCell(const SnapshotCell&);
+    SnapshotCell& operator=(const SnapshotCell&);
+
+    struct Retired {
+        T* value;
+        uint64_t epoch;
+    };
+
+    // Padded rather than aligned, so a cell allocated without over-aligned new still keeps stripes on separate lines.
+    struct ReaderStripe {
+        std::atomic<size_t> counts[2];
+        char padding[SNAPSHOT_READER_STRIPE_LENGTH - 2 * sizeof(std::atomic<size_t>)];
+    };
+
+    void advanceEpoch() {
+        uint64_t epoch = _epoch.load(std::memory_order_relaxed);
+        // Readers of epoch - 1 use the slot that epoch + 1 will reuse.
+        size_t slot = (size_t)((epoch + 1) & 1);
+        for(size_t index = 0; index < SNAPSHOT_READER_STRIPE_COUNT; index++) {
+            if(_readerStripes[index].counts[slot].load(std::memory_order_seq_cst) != 0) {
+                return;
+            }
+        }
+        _epoch.store(epoch + 1, std::memory_order_seq_cst);
+    }
+
+    size_t collect() {
+        uint64_t epoch = _epoch.load(std::memory_order_relaxed);
+        size_t kept = 0;
+        size_t freed = 0;
+        for(size_t index = 0; index < _retired.size(); index++) {
+            if(_retired[index].epoch + 2 <= epoch) {
+                _deleter(_retired[index].value);
+                freed++;
+            } else {
+                _retired[kept++] = _retired[index];
+            }
+        }
+        _retired.resize(kept);
+        _retiredCount.store(kept, std::memory_order_release);
+        return freed;
+    }
+
+    std::atomic<T*> _current;
+    std::atomic<uint64_t> _epoch;
+    mutable ReaderStripe _readerStripes[SNAPSHOT_READER_STRIPE_COUNT];
+    std::atomic<size_t> _retiredCount;
+    std::mutex _writeMutex;
+    std::vector<Retired> _retired;
+    Deleter _deleter;
+};
+
+}
+
+#endif /* GPMSnapshotCell_h */
@@ -0,0 +1,179 @@
+#ifndef GPMStreamAssembler_h
+#define GPMStreamAssembler_h
+
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <mutex>
+
+namespace gpm {
+
+// Reassembles chunked streams, each into a single buffer sized from the length announced at begin,
+// so a payload is never grown or copied while it arrives. Bounds the length of a stream,
+// the number of streams in flight and their total length. Meta is what the stream is delivered with.
+template <typename Meta>
+class StreamAssembler {
+public:
+    enum BeginResult {
+        BEGUN,
+        INVALID_LENGTH,
+        TOO_MANY_STREAMS,
+        OUT_OF_MEMORY
+    };
+
+    enum AppendResult {
+        APPENDED,
+        NO_STREAM,
+        TOO_LONG
+    };
+
+    enum EndResult {
+        ENDED,
+        UNKNOWN_STREAM,
+        INCOMPLETE
+    };
+
+    struct Progress {
+        Meta meta;
+        size_t received;
+        size_t length;
+    };
+
+    // buffer is allocated with malloc and owned by the caller.
+    struct Completed {
+        Meta meta;
+        char* buffer;
+        size_t length;
+    };
+
+    StreamAssembler(size_t maxLength, size_t maxInFlightLength, size_t maxCount)
+        : _maxLength(maxLength), _maxInFlightLength(maxInFlightLength), _maxCount(maxCount), _lastStreamId(0), _inFlightLength(0) {
+    }
+
+    // streamId is set only on BEGUN.
+    BeginResult begin(const Meta& meta, size_t length, long& streamId) {
+        if(length == 0 || length > _maxLength) {
+            return INVALID_LENGTH;
+        }
+
+        std::lock_guard<std::mutex> lock(_mutex);
+        if(_streams.size() >= _maxCount || _inFlightLength + length > _maxInFlightLength) {
+            return TOO_MANY_STREAMS;
+        }
+
+        std::unique_ptr<Stream> stream(new Stream(meta, length));
+        if(stream->buffer == NULL) {
+            return OUT_OF_MEMORY;
+        }
+
+        _lastStreamId++;
+        _inFlightLength += length;
+        _streams[_lastStreamId] = std::move(stream);
+
+        streamId = _lastStreamId;
+        return BEGUN;
+    }
+
+    // On TOO_LONG the stream is left in place, abort it to release it.
+    AppendResult append(long streamId, const char* bytes, size_t length, Progress& progress) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        typename StreamMap::iterator found = _streams.find(streamId);
+        if(found == _streams.end()) {
+            return NO_STREAM;
+        }
+
+        Stream& stream = *found->second;
+        if(length > stream.length - stream.received) {
+            return TOO_LONG;
+        }
+
+        std::memcpy(stream.buffer + stream.received, bytes, length);
+        stream.received += length;
+
+        progress.meta = stream.meta;
+        progress.received = stream.received;
+        progress.length = stream.length;
+        return APPENDED;
+    }
+
+    // Hands the buffer over once every byte arrived. On INCOMPLETE the stream is left in place, abort it to release it.
+    EndResult end(long streamId, Completed& completed) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        typename StreamMap::iterator found = _streams.find(streamId);
+        if(found == _streams.end()) {
+            return UNKNOWN_STREAM;
+        }
+
+        Stream& stream = *found->second;
+        if(stream.received != stream.length) {
+            return INCOMPLETE;
+        }
+
+        completed.meta = stream.meta;
+        completed.buffer = stream.buffer;
+        completed.length = stream.length;
+        stream.buffer = NULL;
+
+        _inFlightLength -= stream.length;
+        _streams.erase(found);
+        return ENDED;
+    }
+
+    bool abort(long streamId, Meta& meta) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        typename StreamMap::iterator found = _streams.find(streamId);
+        if(found == _streams.end()) {
+            return false;
+        }
+
+        meta = found->second->meta;
+        _inFlightLength -= found->second->length;
+        _streams.erase(found);
+        return true;
+    }
+
+    size_t streamCount() const {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _streams.size();
+    }
+
+    size_t inFlightLength() const {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _inFlightLength;
+    }
+
+private:
+    StreamAssembler(const StreamAssembler&);
+    StreamAssembler& operator=(const StreamAssembler&);
+
+    struct Stream {
+        Meta meta;
+        char* buffer;
+        size_t length;
+        size_t received;
+
+        Stream(const Meta& streamMeta, size_t streamLength)
+            : meta(streamMeta), buffer((char*)std::malloc(streamLength)), length(streamLength), received(0) {
+        }
+
+        ~Stream() {
+            std::free(buffer);
+        }
+    };
+
+    typedef std::map<long, std::unique_ptr<Stream> > StreamMap;
+
+    const size_t _maxLength;
+    const size_t _maxInFlightLength;
+    const size_t _maxCount;
+    long _lastStreamId;
+    size_t _inFlightLength;
+    StreamMap _streams;
+    mutable std::mutex _mutex;
+};
+
+}
+
+#endif /* GPMStreamAssembler_h */
@@ -2,10 +2,34 @@
 #import "GPMCommunicatorReceiver.h"
 #import "GPMCommunicatorMessage.h"
 
+#define GPM_COMMUNICATOR_PLUGIN_SEGMENT "__DATA"
+#define GPM_COMMUNICATOR_PLUGIN_SECTION "__gpm_plugins"
+
+typedef struct {
+    __unsafe_unretained NSString* domain;
+    const char* className;
+    id (*create)(void);
+} GPMCommunicatorPluginEntry;
+
+// Registers a plugin class for a domain in a table built at link time.
+// The plugin is created on the first message for its domain, and its init must add the domain receiver. The registry keeps it alive.
+// The section is read as an array, so the alignment is pinned to keep the compiler from padding entries apart.
+#define GPM_COMMUNICATOR_REGISTER_PLUGIN(pluginDomain, pluginClass) \
+    static id GPMCommunicatorCreate##pluginClass(void) { return [[pluginClass alloc] init]; } \
+    __attribute__((used, section(GPM_COMMUNICATOR_PLUGIN_SEGMENT "," GPM_COMMUNICATOR_PLUGIN_SECTION), aligned(sizeof(void*)))) \
+    static const GPMCommunicatorPluginEntry GPMCommunicatorPluginEntry##pluginClass = { pluginDomain, #pluginClass, &GPMCommunicatorCreate##pluginClass };
+
 @interface GPMCommunicatorPlugin: NSObject
 
 + (id)sharedGPMCommunicatorPlugin;
 - (void)addReceiverWithDomain:(NSString*)domain receiver:(GPMCommunicatorReceiver*)receiver;
 - (void)sendResponseWithMessage:(GPMCommunicatorMessage*)message;
+// Drops queued bulk messages of every session of the domain. Control messages are still delivered.
+- (void)cancelPendingMessagesWithDomain:(NSString*)domain;
+// Drops queued bulk messages of one session, the key set by onPrepareMessageAsync or the domain when none was set.
+- (void)cancelPendingMessagesWithSession:(NSString*)session;
+// Handles the domain's queued async messages now, on the calling thread. Only for a caller that asks for it,
+// a query that bypasses onRequestSync should not block on it.
+- (void)drainPendingMessagesWithDomain:(NSString*)domain;
 
 @end
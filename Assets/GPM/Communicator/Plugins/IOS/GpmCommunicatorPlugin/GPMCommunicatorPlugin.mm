@@ -1,6 +1,7 @@
 #import "GPMCommunicatorPlugin.h"
 #import "GPMCommunicator.h"
 #import "GPMCommunicatorReceiver.h"
+#import "GPMMessageDispatcher.h"
 
 @implementation GPMCommunicatorPlugin
 
@@ -20,4 +21,16 @@
 - (void)sendResponseWithMessage:(GPMCommunicatorMessage*)message {
     [[GPMCommunicator sharedGPMCommunicator] sendResponseWithMessage:message];
 }
+
+- (void)cancelPendingMessagesWithDomain:(NSString*)domain {
+    [[GPMMessageDispatcher sharedGPMMessageDispatcher] cancelPendingMessagesWithDomain:domain];
+}
+
+- (void)cancelPendingMessagesWithSession:(NSString*)session {
+    [[GPMMessageDispatcher sharedGPMMessageDispatcher] cancelPendingMessagesWithSession:session];
+}
+
+- (void)drainPendingMessagesWithDomain:(NSString*)domain {
+    [[GPMMessageDispatcher sharedGPMMessageDispatcher] drainMessagesWithDomain:domain];
+}
 @end
@@ -4,10 +4,30 @@
 
 typedef void (^RequestMessageAsync)(GPMCommunicatorMessage*);
 typedef GPMCommunicatorMessage* (^RequestMessageSync)(GPMCommunicatorMessage*);
+typedef void (^PrepareMessageAsync)(GPMCommunicatorMessage*);
+typedef void (^RequestStreamProgress)(NSInteger streamId, NSUInteger received, NSUInteger length);
+typedef void (^RequestStreamAbort)(NSInteger streamId);
 
 @interface GPMCommunicatorReceiver : NSObject
 
+// Receives a GPMCommunicatorReadOnlyMessage, shared with the other receivers of the message.
 @property (nonatomic, strong) RequestMessageAsync onRequestMessageAsync;
 @property (nonatomic, strong) RequestMessageSync onRequestMessageSync;
 
+// Optional. When set, only async messages with the same topic are delivered. nil receives every message of the domain.
+@property (nonatomic, strong) NSString* topic;
+
+// Optional. Called on the calling thread before an async message is queued, to set its priority, session flags and topic.
+// Keep it cheap: classify from extra and leave parsing data to onRequestMessageAsync, which stale messages never reach.
+// Only the first receiver registered for the domain prepares the message; every receiver gets the same read-only copy.
+@property (nonatomic, strong) PrepareMessageAsync onPrepareMessageAsync;
+
+// Optional. Called on the calling thread while a chunked message for the domain is being received.
+// A stream has no topic until it is prepared, so only receivers without a topic are called.
+@property (nonatomic, strong) RequestStreamProgress onRequestStreamProgress;
+@property (nonatomic, strong) RequestStreamAbort onRequestStreamAbort;
+
+// YES when messages of topic reach this receiver.
+- (BOOL)acceptsTopic:(NSString*)topic;
+
 @end
@@ -4,4 +4,7 @@
 
 @implementation GPMCommunicatorReceiver
 
+- (BOOL)acceptsTopic:(NSString*)topic {
+    return self.topic == nil || [self.topic isEqualToString:topic] == YES;
+}
 @end
@@ -3,17 +3,35 @@
 
 @class GPMCommunicatorMessage;
 
+// Build with GPM_COMMUNICATOR_STARTUP_TRACE to log the time from library load to the first dispatched message.
+// Otherwise the hook compiles to nothing, so dispatch pays no message send for it.
+// The table read and the lazy create are benchmarked on the host by Tests/Native/GPMPluginLoaderTest.
+#ifdef GPM_COMMUNICATOR_STARTUP_TRACE
+#define GPM_COMMUNICATOR_TRACE_DISPATCH(domain) [[GPMCommunicator sharedGPMCommunicator] traceDispatchWithDomain:(domain)]
+#else
+#define GPM_COMMUNICATOR_TRACE_DISPATCH(domain) do {} while(0)
+#endif
+
 @interface GPMCommunicator: NSObject
 
 @property (nonatomic, strong)NSString* gameObjectName;
 @property (nonatomic, strong)NSString* methodName;
-@property (nonatomic, strong)NSMutableDictionary* receiverDictionary;
+// In UTF-8 bytes, the same unit as the managed side.
+@property (nonatomic, assign)NSUInteger compressionThreshold;
 
 + (instancetype)sharedGPMCommunicator;
 - (void)setGameObjectName:(NSString*)gameObjectName methodName:(NSString*)methodName;
 - (void)setClassName:(NSString*)className;
+- (void)setCompressionThreshold:(NSUInteger)compressionThreshold;
 - (void)addReceiverWithDomain:(NSString*)domain receiver:(GPMCommunicatorReceiver*)receiver;
 - (GPMCommunicatorReceiver*)getReceiverWithDomain:(NSString*)domain;
+- (NSArray*)getReceiversWithDomain:(NSString*)domain;
+- (GPMCommunicatorReceiver*)getSyncReceiverWithDomain:(NSString*)domain;
+// Releases replaced registry snapshots that no lookup still reads. Call where no lookup is in progress on the calling thread.
+- (void)reclaimRetiredSnapshots;
+#ifdef GPM_COMMUNICATOR_STARTUP_TRACE
+- (void)traceDispatchWithDomain:(NSString*)domain;
+#endif
 - (void)sendResponseWithMessage:(GPMCommunicatorMessage*)message;
 
 @end
@@ -1,26 +1,70 @@
 #import "GPMCommunicator.h"
 #import "GPMCommunicatorReceiver.h"
 #import "GPMCommunicatorMessage.h"
+#import "GPMMessageCompressor.h"
+#import "GPMPluginRegistry.h"
+#import "GPMSnapshotCell.h"
 
 #define GPM_COMMUNICATOR_DELIMITER @"${gpm_communicator}"
 
-@implementation GPMCommunicator
+#ifdef GPM_COMMUNICATOR_STARTUP_TRACE
+#import <mach/mach_time.h>
+
+static uint64_t gpmCommunicatorLoadTime = 0;
+
+__attribute__((constructor)) static void GPMCommunicatorRecordLoadTime(void) {
+    gpmCommunicatorLoadTime = mach_absolute_time();
+}
+#endif
+
+namespace {
+    struct GPMCommunicatorSnapshotRelease {
+        void operator()(const void* snapshot) const {
+            CFRelease(snapshot);
+        }
+    };
+    
+    typedef gpm::SnapshotCell<const void, GPMCommunicatorSnapshotRelease> GPMReceiverSnapshotCell;
+}
+
+// The receiver registry is an immutable NSDictionary snapshot of domain -> NSArray of receivers.
+// Readers look up the current snapshot without locking. Writers copy it and publish the copy,
+// and the cell releases a replaced snapshot once no lookup can still be reading it.
+@implementation GPMCommunicator {
+    GPMReceiverSnapshotCell* _receiverSnapshot;
+}
 
 @synthesize gameObjectName = _gameObjectName;
 @synthesize methodName = _methodName;
-@synthesize receiverDictionary = _receiverDictionary;
+@synthesize compressionThreshold = _compressionThreshold;
+
+- (instancetype)init {
+    if(self = [super init]) {
+        _receiverSnapshot = new GPMReceiverSnapshotCell(CFBridgingRetain([NSDictionary dictionary]));
+    }
+    return self;
+}
+
+- (void)dealloc {
+    delete _receiverSnapshot;
+}
 
 + (instancetype)sharedGPMCommunicator {
     static dispatch_once_t onceToken;
     static GPMCommunicator* instance = nil;
     dispatch_once(&onceToken, ^{
         instance = [[GPMCommunicator alloc] init];
-        instance.receiverDictionary = [NSMutableDictionary dictionary];
+        instance.compressionThreshold = GPM_COMMUNICATOR_COMPRESS_DEFAULT_THRESHOLD;
     });
     return instance;
 }
 
 - (void)setClassName:(NSString*)className {
+    // Statically registered plugins are created on the first message for their domain.
+    if([[GPMPluginRegistry sharedGPMPluginRegistry] containsPluginWithClassName:className] == YES) {
+        return;
+    }
+    
     Class newClass = NSClassFromString(className);
     if(newClass != nil)
     {
@@ -37,28 +81,97 @@
     _methodName = methodName;
 }
 
+- (void)setCompressionThreshold:(NSUInteger)compressionThreshold {
+    _compressionThreshold = MAX(compressionThreshold, (NSUInteger)GPM_COMMUNICATOR_COMPRESS_MIN_THRESHOLD);
+}
+
 - (void)addReceiverWithDomain:(NSString*)domain receiver:(GPMCommunicatorReceiver*)receiver {
-    if([_receiverDictionary objectForKey:domain] != nil) {
-        NSLog(@"%@ : %@", @"The receiver is already registered", domain);
+    if(domain == nil || receiver == nil) {
         return;
     }
     
-    [_receiverDictionary setObject:receiver forKey:domain];
+    _receiverSnapshot->update([&](const void* current) -> const void* {
+        NSDictionary* snapshot = (__bridge NSDictionary*)current;
+        NSArray* receivers = [snapshot objectForKey:domain];
+        if([receivers containsObject:receiver] == YES) {
+            NSLog(@"%@ : %@", @"The receiver is already registered", domain);
+            return nullptr;
+        }
+        
+        // Receiver lists are immutable, a message being dispatched keeps the list it started with.
+        receivers = (receivers == nil) ? @[receiver] : [receivers arrayByAddingObject:receiver];
+        
+        NSMutableDictionary* nextSnapshot = [snapshot mutableCopy];
+        [nextSnapshot setObject:receivers forKey:domain];
+        return CFBridgingRetain([nextSnapshot copy]);
+    });
+}
+
+- (NSArray*)receiversInSnapshotWithDomain:(NSString*)domain {
+    // The strong local retains the array before the guard ends, so it outlives the snapshot.
+    NSArray* receivers = nil;
+    {
+        GPMReceiverSnapshotCell::ReadGuard guard(*_receiverSnapshot);
+        receivers = [(__bridge NSDictionary*)guard.get() objectForKey:domain];
+    }
+    return receivers;
+}
+
+- (void)reclaimRetiredSnapshots {
+    _receiverSnapshot->reclaim();
+    [[GPMPluginRegistry sharedGPMPluginRegistry] reclaimRetiredSnapshots];
 }
 
 - (GPMCommunicatorReceiver*)getReceiverWithDomain:(NSString*)domain {
-    GPMCommunicatorReceiver* receiver = [_receiverDictionary objectForKey:domain];
+    GPMCommunicatorReceiver* receiver = [[self getReceiversWithDomain:domain] firstObject];
     if(receiver == nil) {
         NSLog(@"%@ : %@", @"There is no registered receiver", domain);
     }
     return receiver;
 }
 
+- (NSArray*)getReceiversWithDomain:(NSString*)domain {
+    if(domain == nil) {
+        return nil;
+    }
+    
+    NSArray* receivers = [self receiversInSnapshotWithDomain:domain];
+    if(receivers == nil && [[GPMPluginRegistry sharedGPMPluginRegistry] loadPluginWithDomain:domain] == YES) {
+        receivers = [self receiversInSnapshotWithDomain:domain];
+    }
+    return receivers;
+}
+
+- (GPMCommunicatorReceiver*)getSyncReceiverWithDomain:(NSString*)domain {
+    for(GPMCommunicatorReceiver* receiver in [self getReceiversWithDomain:domain]) {
+        if(receiver.onRequestMessageSync != nil) {
+            return receiver;
+        }
+    }
+    return nil;
+}
+
+#ifdef GPM_COMMUNICATOR_STARTUP_TRACE
+- (void)traceDispatchWithDomain:(NSString*)domain {
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        mach_timebase_info_data_t timebase;
+        mach_timebase_info(&timebase);
+        double elapsed = (double)(mach_absolute_time() - gpmCommunicatorLoadTime) * timebase.numer / timebase.denom / NSEC_PER_MSEC;
+        NSLog(@"%@ : %.3f ms (%@)", @"First message dispatched after load", elapsed, domain);
+    });
+}
+#endif
+
 - (void)sendResponseWithMessage:(GPMCommunicatorMessage*)message {
     if (_gameObjectName == nil || _methodName == nil || message == nil){
     }
     else {
-        NSString* sendMessage = [NSString stringWithFormat:@"%@%@%@%@%@", message.domain, GPM_COMMUNICATOR_DELIMITER, message.data, GPM_COMMUNICATOR_DELIMITER, message.extra];
+        NSString* data = [GPMMessageCompressor compressString:message.data threshold:_compressionThreshold];
+        NSString* sendMessage = [NSString stringWithFormat:@"%@%@%@%@%@", message.domain, GPM_COMMUNICATOR_DELIMITER, data, GPM_COMMUNICATOR_DELIMITER, message.extra];
+        if(message.topic != nil) {
+            sendMessage = [NSString stringWithFormat:@"%@%@%@", sendMessage, GPM_COMMUNICATOR_DELIMITER, message.topic];
+        }
         
         UnitySendMessage([_gameObjectName UTF8String], [_methodName UTF8String], [sendMessage UTF8String]);
     }
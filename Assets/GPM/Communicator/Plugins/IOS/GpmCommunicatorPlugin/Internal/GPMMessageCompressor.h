@@ -0,0 +1,17 @@
+#import <Foundation/Foundation.h>
+
+#define GPM_COMMUNICATOR_COMPRESS_HEADER @"${gpm_compress}"
+// Thresholds and lengths are in bytes of the UTF-8 encoded data.
+#define GPM_COMMUNICATOR_COMPRESS_DEFAULT_THRESHOLD (16 * 1024)
+#define GPM_COMMUNICATOR_COMPRESS_MIN_THRESHOLD 1024
+// Same bound as a chunked stream. Larger data is sent as is, and frames claiming more are rejected.
+#define GPM_COMMUNICATOR_COMPRESS_MAX_LENGTH (64 * 1024 * 1024)
+
+@interface GPMMessageCompressor: NSObject
+
+// Returns string as it is sent: a compressed frame, or string itself, escaped when it starts with the header.
++ (NSString*)compressString:(NSString*)string threshold:(NSUInteger)threshold;
+// Returns nil for a frame that does not decode.
++ (NSString*)decompressString:(NSString*)string;
+
+@end
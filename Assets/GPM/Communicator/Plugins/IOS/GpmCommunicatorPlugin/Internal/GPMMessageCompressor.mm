@@ -0,0 +1,131 @@
+#import "GPMMessageCompressor.h"
+#import "GPMCompressFrame.h"
+#import <compression.h>
+
+// Frame layout and size rule are in GPMCompressFrame.h.
+// Raw deflate (COMPRESSION_ZLIB) is the codec the managed side can read with System.IO.Compression.DeflateStream.
+#define GPM_COMPRESS_LENGTH_DELIMITER @":"
+#define GPM_COMPRESS_STREAM_CHUNK_SIZE (64 * 1024)
+
+@implementation GPMMessageCompressor
+
++ (NSString*)compressString:(NSString*)string threshold:(NSUInteger)threshold {
+    if(string == nil) {
+        return string;
+    }
+    
+    threshold = MAX(threshold, (NSUInteger)GPM_COMMUNICATOR_COMPRESS_MIN_THRESHOLD);
+    // The UTF-8 length is at least the UTF-16 length and at most three times it, so most strings are decided without encoding.
+    if([string length] < threshold && [string maximumLengthOfBytesUsingEncoding:NSUTF8StringEncoding] < threshold) {
+        return [self escapeString:string];
+    }
+    
+    NSData* sourceData = [string dataUsingEncoding:NSUTF8StringEncoding];
+    if(sourceData.length < threshold || sourceData.length > GPM_COMMUNICATOR_COMPRESS_MAX_LENGTH) {
+        return [self escapeString:string];
+    }
+    
+    // Output that does not fit would make the base64 frame at least as long as the source.
+    size_t capacity = gpm::maxCompressedLength(sourceData.length);
+    if(capacity == 0) {
+        return [self escapeString:string];
+    }
+    NSMutableData* compressedData = [NSMutableData dataWithLength:capacity];
+    
+    size_t compressedLength = compression_encode_buffer((uint8_t*)compressedData.mutableBytes, compressedData.length,
+                                                        (const uint8_t*)sourceData.bytes, sourceData.length,
+                                                        NULL, COMPRESSION_ZLIB);
+    if(gpm::isCompressedFrameSmaller(sourceData.length, compressedLength) == false) {
+        return [self escapeString:string];
+    }
+    compressedData.length = compressedLength;
+    
+    return [NSString stringWithFormat:@"%@%lu%@%@", GPM_COMMUNICATOR_COMPRESS_HEADER, (unsigned long)sourceData.length, GPM_COMPRESS_LENGTH_DELIMITER, [compressedData base64EncodedStringWithOptions:0]];
+}
+
++ (NSString*)decompressString:(NSString*)string {
+    if(string == nil || [string hasPrefix:GPM_COMMUNICATOR_COMPRESS_HEADER] == NO) {
+        return string;
+    }
+    
+    NSUInteger headerLength = [GPM_COMMUNICATOR_COMPRESS_HEADER length];
+    if([string length] > headerLength && [string characterAtIndex:headerLength] == gpm::COMPRESS_LENGTH_DELIMITER) {
+        return [string substringFromIndex:headerLength + 1];
+    }
+    
+    NSRange delimiterRange = [string rangeOfString:GPM_COMPRESS_LENGTH_DELIMITER options:0 range:NSMakeRange(headerLength, [string length] - headerLength)];
+    if(delimiterRange.location == NSNotFound) {
+        NSLog(@"%@", @"Invalid compressed message header");
+        return nil;
+    }
+    
+    long long decodedLength = [[string substringWithRange:NSMakeRange(headerLength, delimiterRange.location - headerLength)] longLongValue];
+    NSData* compressedData = [[NSData alloc] initWithBase64EncodedString:[string substringFromIndex:NSMaxRange(delimiterRange)] options:0];
+    if(decodedLength <= 0 || decodedLength > GPM_COMMUNICATOR_COMPRESS_MAX_LENGTH || compressedData == nil) {
+        NSLog(@"%@", @"Invalid compressed message body");
+        return nil;
+    }
+    
+    NSMutableData* decodedData = [self inflateData:compressedData decodedLength:(NSUInteger)decodedLength];
+    if(decodedData == nil) {
+        NSLog(@"%@", @"Failed to decompress message");
+        return nil;
+    }
+    
+    return [[NSString alloc] initWithData:decodedData encoding:NSUTF8StringEncoding];
+}
+
+#pragma mark - private
+
++ (NSString*)escapeString:(NSString*)string {
+    if([string hasPrefix:GPM_COMMUNICATOR_COMPRESS_HEADER] == NO) {
+        return string;
+    }
+    return [NSString stringWithFormat:@"%@%@%@", GPM_COMMUNICATOR_COMPRESS_HEADER, GPM_COMPRESS_LENGTH_DELIMITER, string];
+}
+
+// Streams into a single buffer sized from the frame header, so the output is never grown or copied.
++ (NSMutableData*)inflateData:(NSData*)compressedData decodedLength:(NSUInteger)decodedLength {
+    NSMutableData* decodedData = [NSMutableData dataWithLength:decodedLength];
+    if(decodedData == nil) {
+        return nil;
+    }
+    
+    compression_stream stream;
+    if(compression_stream_init(&stream, COMPRESSION_STREAM_DECODE, COMPRESSION_ZLIB) != COMPRESSION_STATUS_OK) {
+        return nil;
+    }
+    
+    const uint8_t* source = (const uint8_t*)compressedData.bytes;
+    size_t sourceRemaining = compressedData.length;
+    
+    stream.dst_ptr = (uint8_t*)decodedData.mutableBytes;
+    stream.dst_size = decodedLength;
+    stream.src_ptr = source;
+    stream.src_size = 0;
+    
+    compression_status status = COMPRESSION_STATUS_OK;
+    while(status == COMPRESSION_STATUS_OK) {
+        if(stream.src_size == 0 && sourceRemaining > 0) {
+            size_t chunkSize = MIN(sourceRemaining, (size_t)GPM_COMPRESS_STREAM_CHUNK_SIZE);
+            stream.src_ptr = source + (compressedData.length - sourceRemaining);
+            stream.src_size = chunkSize;
+            sourceRemaining -= chunkSize;
+        }
+        
+        int flags = (sourceRemaining == 0) ? COMPRESSION_STREAM_FINALIZE : 0;
+        status = compression_stream_process(&stream, flags);
+        
+        if(status == COMPRESSION_STATUS_OK && stream.dst_size == 0 && (stream.src_size > 0 || sourceRemaining > 0)) {
+            status = COMPRESSION_STATUS_ERROR;
+        }
+    }
+    
+    compression_stream_destroy(&stream);
+    
+    if(status != COMPRESSION_STATUS_END || stream.dst_size != 0) {
+        return nil;
+    }
+    return decodedData;
+}
+@end
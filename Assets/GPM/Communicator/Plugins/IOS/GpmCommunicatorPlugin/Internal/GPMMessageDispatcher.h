@@ -0,0 +1,13 @@
+#import <Foundation/Foundation.h>
+
+@class GPMCommunicatorMessage;
+
+@interface GPMMessageDispatcher: NSObject
+
++ (instancetype)sharedGPMMessageDispatcher;
+- (void)dispatchMessage:(GPMCommunicatorMessage*)message;
+- (void)cancelPendingMessagesWithDomain:(NSString*)domain;
+- (void)cancelPendingMessagesWithSession:(NSString*)session;
+- (void)drainMessagesWithDomain:(NSString*)domain;
+
+@end
@@ -0,0 +1,146 @@
+#import "GPMMessageDispatcher.h"
+#import "GPMCommunicator.h"
+#import "GPMCommunicatorMessage.h"
+#import "GPMCommunicatorReceiver.h"
+#import "GPMDispatchLanes.h"
+#import <atomic>
+
+// Messages delivered per main queue pass, so a saturated lane does not hold the frame.
+#define GPM_DISPATCHER_DRAIN_BUDGET 32
+
+static std::string GPMDispatcherString(NSString* string) {
+    return (string != nil) ? std::string([string UTF8String]) : std::string();
+}
+
+@implementation GPMMessageDispatcher {
+    gpm::DispatchLanes<GPMCommunicatorMessage*> _lanes;
+    std::atomic<size_t> _pendingCount;
+    BOOL _drainScheduled;
+}
+
++ (instancetype)sharedGPMMessageDispatcher {
+    static dispatch_once_t onceToken;
+    static GPMMessageDispatcher* instance = nil;
+    dispatch_once(&onceToken, ^{
+        instance = [[GPMMessageDispatcher alloc] init];
+    });
+    return instance;
+}
+
+- (void)dispatchMessage:(GPMCommunicatorMessage*)message {
+    BOOL scheduleDrain = NO;
+    
+    @synchronized(self) {
+        gpm::DispatchPriority priority = (message.priority == GPMCommunicatorMessagePriorityControl) ? gpm::DispatchPriorityControl : gpm::DispatchPriorityBulk;
+        // Copied once here, so later changes by the sender never reach receivers.
+        _lanes.push([message copy], GPMDispatcherString(message.domain), GPMDispatcherString([self sessionWithMessage:message]), priority, message.endsSession == YES);
+        _pendingCount.store(_lanes.size(), std::memory_order_release);
+        
+        if(_drainScheduled == NO) {
+            _drainScheduled = YES;
+            scheduleDrain = YES;
+        }
+    }
+    
+    if(scheduleDrain == YES) {
+        [self scheduleDrain];
+    }
+}
+
+- (void)cancelPendingMessagesWithDomain:(NSString*)domain {
+    if(domain == nil) {
+        return;
+    }
+    
+    @synchronized(self) {
+        _lanes.cancelDomain(GPMDispatcherString(domain));
+    }
+}
+
+- (void)cancelPendingMessagesWithSession:(NSString*)session {
+    if(session == nil) {
+        return;
+    }
+    
+    @synchronized(self) {
+        _lanes.cancelSession(GPMDispatcherString(session));
+    }
+}
+
+// Delivers the domain's queued messages now, so a sync request sees the effect of every async request sent before it.
+// Receivers run on the main thread, so a call from another thread leaves the messages to the scheduled drain.
+- (void)drainMessagesWithDomain:(NSString*)domain {
+    if(domain == nil || _pendingCount.load(std::memory_order_acquire) == 0 || [NSThread isMainThread] == NO) {
+        return;
+    }
+    
+    GPMCommunicatorMessage* message = nil;
+    while((message = [self dequeueMessageWithDomain:domain]) != nil) {
+        [self deliverMessage:message];
+    }
+}
+
+#pragma mark - private
+
+- (NSString*)sessionWithMessage:(GPMCommunicatorMessage*)message {
+    return (message.session != nil) ? message.session : message.domain;
+}
+
+- (void)scheduleDrain {
+    dispatch_async(dispatch_get_main_queue(), ^{
+        [self drainMessages];
+    });
+}
+
+- (void)drainMessages {
+    for(NSUInteger count = 0; count < GPM_DISPATCHER_DRAIN_BUDGET; count++) {
+        GPMCommunicatorMessage* message = [self dequeueMessage];
+        if(message == nil) {
+            // Quiescent point: no lookup of this pass is still reading a registry snapshot.
+            [[GPMCommunicator sharedGPMCommunicator] reclaimRetiredSnapshots];
+            return;
+        }
+        [self deliverMessage:message];
+    }
+    
+    [self scheduleDrain];
+}
+
+- (void)deliverMessage:(GPMCommunicatorMessage*)message {
+    for(GPMCommunicatorReceiver* receiver in [[GPMCommunicator sharedGPMCommunicator] getReceiversWithDomain:message.domain]) {
+        if(receiver.onRequestMessageAsync == nil) {
+            continue;
+        }
+        if([receiver acceptsTopic:message.topic] == NO) {
+            continue;
+        }
+        receiver.onRequestMessageAsync(message);
+    }
+    GPM_COMMUNICATOR_TRACE_DISPATCH(message.domain);
+}
+
+- (GPMCommunicatorMessage*)dequeueMessage {
+    @synchronized(self) {
+        GPMCommunicatorMessage* message = nil;
+        bool dequeued = _lanes.pop(message);
+        _pendingCount.store(_lanes.size(), std::memory_order_release);
+        
+        if(dequeued == false) {
+            _drainScheduled = NO;
+            return nil;
+        }
+        return message;
+    }
+}
+
+// Leaves _drainScheduled alone, the scheduled drain still owns the remaining messages.
+- (GPMCommunicatorMessage*)dequeueMessageWithDomain:(NSString*)domain {
+    @synchronized(self) {
+        GPMCommunicatorMessage* message = nil;
+        bool dequeued = _lanes.pop(message, GPMDispatcherString(domain));
+        _pendingCount.store(_lanes.size(), std::memory_order_release);
+        
+        return (dequeued == true) ? message : nil;
+    }
+}
+@end
@@ -1,9 +1,26 @@
 #import "GPMCommunicator.h"
 #import "GPMCommunicatorMessage.h"
 #import "GPMCommunicatorReceiver.h"
+#import "GPMMessageDispatcher.h"
+#import "GPMMessageCompressor.h"
+#import "GPMMessageStreamAssembler.h"
 
 #define GPM_COMMUNICATOR_DELIMITER @"${gpm_communicator}"
 
+static void dispatchAsyncMessage(GPMCommunicatorMessage* message) {
+    GPMCommunicatorReceiver* receiver = [[GPMCommunicator sharedGPMCommunicator] getReceiverWithDomain:message.domain];
+    if(receiver == nil) {
+        NSLog(@"%@ : %@", @"There is no registered receiver", message.domain);
+        return;
+    }
+    
+    if(receiver.onPrepareMessageAsync != nil) {
+        receiver.onPrepareMessageAsync(message);
+    }
+    
+    [[GPMMessageDispatcher sharedGPMMessageDispatcher] dispatchMessage:message];
+}
+
 #pragma mark - extern C
 extern "C" {
     void initializeUnityObject(char* gameObjectName, char* methodName)
@@ -34,6 +51,11 @@ extern "C" {
         [[GPMCommunicator sharedGPMCommunicator] setClassName:iosClassName];
     }
     
+    void setCompressionThreshold(int threshold)
+    {
+        [[GPMCommunicator sharedGPMCommunicator] setCompressionThreshold:(NSUInteger)MAX(threshold, 0)];
+    }
+    
     char* onRequestSync(char* domain, char* data, char* extra) {
         NSString *iosDomain;
         
@@ -44,7 +66,7 @@ extern "C" {
         NSString *iosData;
         
         if(data != nil) {
-            iosData = [NSString stringWithUTF8String:data];
+            iosData = [GPMMessageCompressor decompressString:[NSString stringWithUTF8String:data]];
         }
         
         NSString *iosExtra;
@@ -53,16 +75,21 @@ extern "C" {
             iosExtra = [NSString stringWithUTF8String:extra];
         }
         
+        // Async requests sent earlier for the domain are handled first, as they were before they were queued.
+        [[GPMMessageDispatcher sharedGPMMessageDispatcher] drainMessagesWithDomain:iosDomain];
+        
         GPMCommunicatorMessage* message = [[GPMCommunicatorMessage alloc] initWithDomain:iosDomain data:iosData extra:iosExtra];
-        GPMCommunicatorReceiver* receiver = [[GPMCommunicator sharedGPMCommunicator] getReceiverWithDomain:iosDomain];
+        GPMCommunicatorReceiver* receiver = [[GPMCommunicator sharedGPMCommunicator] getSyncReceiverWithDomain:iosDomain];
         if(receiver == nil) {
             NSLog(@"%@ : %@", @"There is no registered receiver", iosDomain);
             return (char*)[@"" UTF8String];
         }
         
         GPMCommunicatorMessage* responseMessage = receiver.onRequestMessageSync(message);
+        GPM_COMMUNICATOR_TRACE_DISPATCH(iosDomain);
 
-        NSString* responseString = [NSString stringWithFormat:@"%@%@%@%@%@", responseMessage.domain, GPM_COMMUNICATOR_DELIMITER, responseMessage.data, GPM_COMMUNICATOR_DELIMITER, responseMessage.extra];
+        NSString* responseData = [GPMMessageCompressor compressString:responseMessage.data threshold:[GPMCommunicator sharedGPMCommunicator].compressionThreshold];
+        NSString* responseString = [NSString stringWithFormat:@"%@%@%@%@%@", responseMessage.domain, GPM_COMMUNICATOR_DELIMITER, responseData, GPM_COMMUNICATOR_DELIMITER, responseMessage.extra];
 
         return (char*)[responseString UTF8String];
     }
@@ -77,7 +104,7 @@ extern "C" {
         NSString *iosData;
         
         if(data != nil) {
-            iosData = [NSString stringWithUTF8String:data];
+            iosData = [GPMMessageCompressor decompressString:[NSString stringWithUTF8String:data]];
         }
         
         NSString *iosExtra;
@@ -87,12 +114,48 @@ extern "C" {
         }
         
         GPMCommunicatorMessage* message = [[GPMCommunicatorMessage alloc] initWithDomain:iosDomain data:iosData extra:iosExtra];
-        GPMCommunicatorReceiver* receiver = [[GPMCommunicator sharedGPMCommunicator] getReceiverWithDomain:iosDomain];
-        if(receiver == nil) {
-            NSLog(@"%@ : %@", @"There is no registered receiver", iosDomain);
+        dispatchAsyncMessage(message);
+    }
+    
+    int beginRequestStream(char* domain, char* extra, int length) {
+        NSString *iosDomain;
+        
+        if(domain != nil) {
+            iosDomain = [NSString stringWithUTF8String:domain];
+        }
+        
+        NSString *iosExtra;
+        
+        if(extra != nil) {
+            iosExtra = [NSString stringWithUTF8String:extra];
+        }
+        
+        if(length <= 0) {
+            return GPM_COMMUNICATOR_INVALID_STREAM_ID;
+        }
+        
+        return (int)[[GPMMessageStreamAssembler sharedGPMMessageStreamAssembler] beginStreamWithDomain:iosDomain extra:iosExtra length:(NSUInteger)length];
+    }
+    
+    bool appendRequestStream(int streamId, char* chunk) {
+        if(chunk == nil) {
+            return true;
+        }
+        
+        return [[GPMMessageStreamAssembler sharedGPMMessageStreamAssembler] appendStream:streamId bytes:chunk length:strlen(chunk)] == YES;
+    }
+    
+    void endRequestStream(int streamId) {
+        GPMCommunicatorMessage* message = [[GPMMessageStreamAssembler sharedGPMMessageStreamAssembler] endStream:streamId];
+        if(message == nil) {
             return;
         }
         
-        [[GPMCommunicator sharedGPMCommunicator] getReceiverWithDomain:iosDomain].onRequestMessageAsync(message);
+        message.data = [GPMMessageCompressor decompressString:message.data];
+        dispatchAsyncMessage(message);
+    }
+    
+    void abortRequestStream(int streamId) {
+        [[GPMMessageStreamAssembler sharedGPMMessageStreamAssembler] abortStream:streamId];
     }
 }
@@ -0,0 +1,15 @@
+#import <Foundation/Foundation.h>
+
+@class GPMCommunicatorMessage;
+
+#define GPM_COMMUNICATOR_INVALID_STREAM_ID -1
+
+@interface GPMMessageStreamAssembler: NSObject
+
++ (instancetype)sharedGPMMessageStreamAssembler;
+- (NSInteger)beginStreamWithDomain:(NSString*)domain extra:(NSString*)extra length:(NSUInteger)length;
+- (BOOL)appendStream:(NSInteger)streamId bytes:(const char*)bytes length:(NSUInteger)length;
+- (GPMCommunicatorMessage*)endStream:(NSInteger)streamId;
+- (void)abortStream:(NSInteger)streamId;
+
+@end
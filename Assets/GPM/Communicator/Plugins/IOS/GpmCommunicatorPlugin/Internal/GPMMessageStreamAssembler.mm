@@ -0,0 +1,126 @@
+#import "GPMMessageStreamAssembler.h"
+#import "GPMCommunicator.h"
+#import "GPMCommunicatorMessage.h"
+#import "GPMCommunicatorReceiver.h"
+#import "GPMStreamAssembler.h"
+
+#define GPM_STREAM_MAX_LENGTH (64 * 1024 * 1024)
+#define GPM_STREAM_MAX_IN_FLIGHT_LENGTH (96 * 1024 * 1024)
+#define GPM_STREAM_MAX_COUNT 8
+
+namespace {
+    struct GPMStreamMeta {
+        NSString* domain;
+        NSString* extra;
+    };
+    
+    typedef gpm::StreamAssembler<GPMStreamMeta> GPMStreamCore;
+}
+
+// Buffer and bounds accounting is in GPMStreamAssembler.h, this class logs and notifies receivers.
+@implementation GPMMessageStreamAssembler {
+    GPMStreamCore* _core;
+}
+
++ (instancetype)sharedGPMMessageStreamAssembler {
+    static dispatch_once_t onceToken;
+    static GPMMessageStreamAssembler* instance = nil;
+    dispatch_once(&onceToken, ^{
+        instance = [[GPMMessageStreamAssembler alloc] init];
+    });
+    return instance;
+}
+
+- (instancetype)init {
+    if(self = [super init]) {
+        _core = new GPMStreamCore(GPM_STREAM_MAX_LENGTH, GPM_STREAM_MAX_IN_FLIGHT_LENGTH, GPM_STREAM_MAX_COUNT);
+    }
+    return self;
+}
+
+- (void)dealloc {
+    delete _core;
+}
+
+- (NSInteger)beginStreamWithDomain:(NSString*)domain extra:(NSString*)extra length:(NSUInteger)length {
+    GPMStreamMeta meta;
+    meta.domain = domain;
+    meta.extra = extra;
+    
+    long streamId = GPM_COMMUNICATOR_INVALID_STREAM_ID;
+    switch(_core->begin(meta, length, streamId)) {
+        case GPMStreamCore::BEGUN:
+            return streamId;
+        case GPMStreamCore::INVALID_LENGTH:
+            NSLog(@"%@ : %lu", @"Invalid stream length", (unsigned long)length);
+            break;
+        case GPMStreamCore::TOO_MANY_STREAMS:
+            NSLog(@"%@ : %@", @"Too many streams in flight", domain);
+            break;
+        case GPMStreamCore::OUT_OF_MEMORY:
+            NSLog(@"%@ : %lu", @"Failed to allocate stream", (unsigned long)length);
+            break;
+    }
+    return GPM_COMMUNICATOR_INVALID_STREAM_ID;
+}
+
+- (BOOL)appendStream:(NSInteger)streamId bytes:(const char*)bytes length:(NSUInteger)length {
+    GPMStreamCore::Progress progress;
+    GPMStreamCore::AppendResult result = _core->append(streamId, bytes, length, progress);
+    if(result == GPMStreamCore::NO_STREAM) {
+        NSLog(@"%@ : %ld", @"There is no stream", (long)streamId);
+        return NO;
+    }
+    
+    if(result == GPMStreamCore::TOO_LONG) {
+        NSLog(@"%@ : %ld", @"Stream overflow", (long)streamId);
+        [self abortStream:streamId];
+        return NO;
+    }
+    
+    for(GPMCommunicatorReceiver* receiver in [[GPMCommunicator sharedGPMCommunicator] getReceiversWithDomain:progress.meta.domain]) {
+        if(receiver.onRequestStreamProgress != nil && [receiver acceptsTopic:nil] == YES) {
+            receiver.onRequestStreamProgress(streamId, progress.received, progress.length);
+        }
+    }
+    return YES;
+}
+
+- (GPMCommunicatorMessage*)endStream:(NSInteger)streamId {
+    GPMStreamCore::Completed completed;
+    GPMStreamCore::EndResult result = _core->end(streamId, completed);
+    if(result == GPMStreamCore::UNKNOWN_STREAM) {
+        NSLog(@"%@ : %ld", @"There is no stream", (long)streamId);
+        return nil;
+    }
+    
+    if(result == GPMStreamCore::INCOMPLETE) {
+        NSLog(@"%@ : %ld", @"Stream ended before all data was received", (long)streamId);
+        [self abortStream:streamId];
+        return nil;
+    }
+    
+    // The string takes ownership of the buffer, so the payload is not copied again.
+    NSString* data = [[NSString alloc] initWithBytesNoCopy:completed.buffer length:completed.length encoding:NSUTF8StringEncoding freeWhenDone:YES];
+    if(data == nil) {
+        NSLog(@"%@ : %ld", @"Stream is not valid UTF-8", (long)streamId);
+        free(completed.buffer);
+        return nil;
+    }
+    
+    return [[GPMCommunicatorMessage alloc] initWithDomain:completed.meta.domain data:data extra:completed.meta.extra];
+}
+
+- (void)abortStream:(NSInteger)streamId {
+    GPMStreamMeta meta;
+    if(_core->abort(streamId, meta) == false) {
+        return;
+    }
+    
+    for(GPMCommunicatorReceiver* receiver in [[GPMCommunicator sharedGPMCommunicator] getReceiversWithDomain:meta.domain]) {
+        if(receiver.onRequestStreamAbort != nil && [receiver acceptsTopic:nil] == YES) {
+            receiver.onRequestStreamAbort(streamId);
+        }
+    }
+}
+@end
@@ -0,0 +1,11 @@
+#import <Foundation/Foundation.h>
+
+@interface GPMPluginRegistry: NSObject
+
++ (instancetype)sharedGPMPluginRegistry;
+- (BOOL)containsPluginWithClassName:(NSString*)className;
+// Creates the domain's plugins on the first miss. YES when a receiver may have been added since the caller looked.
+- (BOOL)loadPluginWithDomain:(NSString*)domain;
+- (void)reclaimRetiredSnapshots;
+
+@end
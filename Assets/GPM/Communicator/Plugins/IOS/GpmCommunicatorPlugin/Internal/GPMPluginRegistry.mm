@@ -0,0 +1,95 @@
+#import "GPMPluginRegistry.h"
+#import "GPMCommunicatorPlugin.h"
+#import "GPMPluginLoader.h"
+#import <dlfcn.h>
+#import <mach-o/getsect.h>
+
+static void GPMPluginRegistryImageAnchor(void) {
+}
+
+namespace {
+    typedef gpm::PluginLoader<GPMCommunicatorPluginEntry> GPMPluginEntryLoader;
+}
+
+// Scanning, lazy creation and the once-per-domain bookkeeping are in GPMPluginLoader.h.
+@implementation GPMPluginRegistry {
+    GPMPluginEntryLoader* _loader;
+    // Created plugins, kept alive for the life of the process like the class-name path's singletons.
+    NSMutableArray* _pluginArray;
+}
+
++ (instancetype)sharedGPMPluginRegistry {
+    static dispatch_once_t onceToken;
+    static GPMPluginRegistry* instance = nil;
+    dispatch_once(&onceToken, ^{
+        instance = [[GPMPluginRegistry alloc] init];
+    });
+    return instance;
+}
+
+- (instancetype)init {
+    if(self = [super init]) {
+        _pluginArray = [NSMutableArray array];
+        
+        // Plugins are linked into the same image as the communicator, so only that image's section is read.
+        const GPMCommunicatorPluginEntry* entries = NULL;
+        size_t entryCount = 0;
+        Dl_info info;
+        if(dladdr((const void*)&GPMPluginRegistryImageAnchor, &info) != 0 && info.dli_fbase != NULL) {
+            unsigned long size = 0;
+            uint8_t* section = getsectiondata((const struct mach_header_64*)info.dli_fbase, GPM_COMMUNICATOR_PLUGIN_SEGMENT, GPM_COMMUNICATOR_PLUGIN_SECTION, &size);
+            entries = (const GPMCommunicatorPluginEntry*)section;
+            entryCount = (section != NULL) ? size / sizeof(GPMCommunicatorPluginEntry) : 0;
+        }
+        _loader = new GPMPluginEntryLoader(entries, entryCount);
+    }
+    return self;
+}
+
+- (void)dealloc {
+    delete _loader;
+}
+
+- (BOOL)containsPluginWithClassName:(NSString*)className {
+    if(className == nil) {
+        return NO;
+    }
+    
+    const char* name = [className UTF8String];
+    for(size_t index = 0; index < _loader->entryCount(); index++) {
+        if(strcmp(_loader->entries()[index].className, name) == 0) {
+            return YES;
+        }
+    }
+    return NO;
+}
+
+- (BOOL)loadPluginWithDomain:(NSString*)domain {
+    if(domain == nil) {
+        return NO;
+    }
+    
+    NSMutableArray* plugins = [NSMutableArray array];
+    bool loaded = _loader->load(std::string([domain UTF8String]), [&](const GPMCommunicatorPluginEntry& entry) -> bool {
+        return [entry.domain isEqualToString:domain] == YES;
+    }, [&](const GPMCommunicatorPluginEntry& entry) -> bool {
+        id plugin = entry.create();
+        if(plugin == nil) {
+            return false;
+        }
+        [plugins addObject:plugin];
+        return true;
+    });
+    
+    if([plugins count] > 0) {
+        @synchronized(_pluginArray) {
+            [_pluginArray addObjectsFromArray:plugins];
+        }
+    }
+    return loaded == true;
+}
+
+- (void)reclaimRetiredSnapshots {
+    _loader->reclaim();
+}
+@end
@@ -1,11 +1,31 @@
 #import <Foundation/Foundation.h>
 
-@interface GPMCommunicatorMessage : NSObject
+typedef NS_ENUM(NSInteger, GPMCommunicatorMessagePriority) {
+    GPMCommunicatorMessagePriorityBulk = 0,
+    GPMCommunicatorMessagePriorityControl = 1
+};
 
-@property (nonatomic, strong) NSString* domain;
-@property (nonatomic, strong) NSString* data;
-@property (nonatomic, strong) NSString* extra;
+// copy returns a GPMCommunicatorReadOnlyMessage, mutableCopy a GPMCommunicatorMessage.
+@interface GPMCommunicatorMessage : NSObject <NSCopying, NSMutableCopying>
+
+@property (nonatomic, copy) NSString* domain;
+@property (nonatomic, copy) NSString* data;
+@property (nonatomic, copy) NSString* extra;
+@property (nonatomic, copy) NSString* topic;
+
+// Async dispatch only. Set by the receiver's onPrepareMessageAsync before the message is queued.
+@property (nonatomic, assign) GPMCommunicatorMessagePriority priority;
+@property (nonatomic, assign) BOOL endsSession;
+// Key whose pending bulk messages endsSession drops. nil means the domain.
+@property (nonatomic, copy) NSString* session;
 
 - (instancetype)initWithDomain:(NSString*)domain data:(NSString*)data extra:(NSString*)extra;
 
 @end
+
+// What onRequestMessageAsync receives. Receivers of one message share the instance,
+// so setting a property raises NSInternalInconsistencyException instead of changing what the others see.
+// Use mutableCopy to build a response from it.
+@interface GPMCommunicatorReadOnlyMessage : GPMCommunicatorMessage
+
+@end
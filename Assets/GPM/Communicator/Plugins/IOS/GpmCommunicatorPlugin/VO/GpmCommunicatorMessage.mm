@@ -1,18 +1,92 @@
 #import "GPMCommunicatorMessage.h"
 
+@interface GPMCommunicatorMessage ()
+
+- (instancetype)initWithMessage:(GPMCommunicatorMessage*)message;
+
+@end
+
 @implementation GPMCommunicatorMessage
 
 @synthesize domain = _domain;
 @synthesize data = _data;
 @synthesize extra = _extra;
+@synthesize topic = _topic;
+@synthesize priority = _priority;
+@synthesize endsSession = _endsSession;
+@synthesize session = _session;
 
 - (instancetype)initWithDomain:(NSString*)domain data:(NSString*)data extra:(NSString*)extra {
     if(self = [super init]){
-        _domain = domain;
-        _data = data;
-        _extra = extra;
+        _domain = [domain copy];
+        _data = [data copy];
+        _extra = [extra copy];
+        _priority = GPMCommunicatorMessagePriorityBulk;
+    }
+    
+    return self;
+}
+
+- (instancetype)initWithMessage:(GPMCommunicatorMessage*)message {
+    if(self = [super init]){
+        _domain = message.domain;
+        _data = message.data;
+        _extra = message.extra;
+        _topic = message.topic;
+        _priority = message.priority;
+        _endsSession = message.endsSession;
+        _session = message.session;
     }
     
     return self;
 }
+
+- (id)copyWithZone:(NSZone*)zone {
+    return [[GPMCommunicatorReadOnlyMessage allocWithZone:zone] initWithMessage:self];
+}
+
+- (id)mutableCopyWithZone:(NSZone*)zone {
+    return [[GPMCommunicatorMessage allocWithZone:zone] initWithMessage:self];
+}
+@end
+
+@implementation GPMCommunicatorReadOnlyMessage
+
+- (id)copyWithZone:(NSZone*)zone {
+    return self;
+}
+
+- (void)setDomain:(NSString*)domain {
+    [self raiseReadOnly];
+}
+
+- (void)setData:(NSString*)data {
+    [self raiseReadOnly];
+}
+
+- (void)setExtra:(NSString*)extra {
+    [self raiseReadOnly];
+}
+
+- (void)setTopic:(NSString*)topic {
+    [self raiseReadOnly];
+}
+
+- (void)setPriority:(GPMCommunicatorMessagePriority)priority {
+    [self raiseReadOnly];
+}
+
+- (void)setEndsSession:(BOOL)endsSession {
+    [self raiseReadOnly];
+}
+
+- (void)setSession:(NSString*)session {
+    [self raiseReadOnly];
+}
+
+#pragma mark - private
+
+- (void)raiseReadOnly {
+    [NSException raise:NSInternalInconsistencyException format:@"%@ : %@", @"The message is read-only, use mutableCopy", self.domain];
+}
 @end
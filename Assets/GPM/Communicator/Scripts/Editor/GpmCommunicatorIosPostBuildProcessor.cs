@@ -0,0 +1,38 @@
+﻿#if UNITY_EDITOR && UNITY_IOS
+namespace Gpm.Communicator.Editor
+{
+    using System.IO;
+    using UnityEditor;
+    using UnityEditor.Build;
+    using UnityEditor.Build.Reporting;
+    using UnityEditor.iOS.Xcode;
+
+    public class GpmCommunicatorIosPostBuildProcessor : IPostprocessBuildWithReport
+    {
+        // GPMMessageCompressor uses the Compression library.
+        private const string COMPRESSION_LIBRARY = "libcompression.tbd";
+
+        public int callbackOrder { get { return 1; } }
+
+        public void OnPostprocessBuild(BuildReport report)
+        {
+            if (report.summary.platform != BuildTarget.iOS)
+            {
+                return;
+            }
+
+            string projectPath = PBXProject.GetPBXProjectPath(report.summary.outputPath);
+
+            var project = new PBXProject();
+            project.ReadFromFile(projectPath);
+
+            string targetGuid = project.GetUnityFrameworkTargetGuid();
+            if (project.ContainsFramework(targetGuid, COMPRESSION_LIBRARY) == false)
+            {
+                project.AddFrameworkToProject(targetGuid, COMPRESSION_LIBRARY, false);
+                File.WriteAllText(projectPath, project.WriteToString());
+            }
+        }
+    }
+}
+#endif
@@ -11,9 +11,26 @@
             CommunicatorImplementation.Instance.InitializeClass(configuration);
         }
 
+        /// <summary>
+        /// Message data of at least threshold bytes, counted in UTF-8, is sent compressed. Values below 1024 are raised to 1024.
+        /// Data over 64 MB is sent uncompressed.
+        /// </summary>
+        public static void SetCompressionThreshold(int threshold)
+        {
+            CommunicatorImplementation.Instance.SetCompressionThreshold(threshold);
+        }
+
         public static void AddReceiver(string domain, GpmCommunicatorCallback.CommunicatorCallback callback)
         {            
-            CommunicatorImplementation.Instance.AddReceiver(domain, callback);
+            CommunicatorImplementation.Instance.AddReceiver(domain, null, callback);
+        }
+
+        /// <summary>
+        /// Several receivers can be registered to a domain. With a topic, only messages of that topic are received.
+        /// </summary>
+        public static void AddReceiver(string domain, string topic, GpmCommunicatorCallback.CommunicatorCallback callback)
+        {
+            CommunicatorImplementation.Instance.AddReceiver(domain, topic, callback);
         }
 
         public static GpmCommunicatorVO.Message CallSync(GpmCommunicatorVO.Message message)
@@ -21,9 +38,30 @@
             return CommunicatorImplementation.Instance.CallSync(message);
         }
 
+        /// <summary>
+        /// Data over 1M characters is sent as a stream, see CallAsyncStream.
+        /// </summary>
         public static void CallAsync(GpmCommunicatorVO.Message message)
         {
             CommunicatorImplementation.Instance.CallAsync(message);
         }
+
+        /// <summary>
+        /// Compresses off the main thread and sends the data in chunks over several frames.
+        /// Async messages sent later wait behind the stream, so the native plugin receives them in call order.
+        /// Where streaming is unavailable the data is sent in a single call.
+        /// </summary>
+        public static GpmCommunicatorStream CallAsyncStream(GpmCommunicatorVO.Message message, GpmCommunicatorCallback.StreamCallback callback)
+        {
+            return CommunicatorImplementation.Instance.CallAsyncStream(message, callback);
+        }
+
+        /// <summary>
+        /// Sends every queued async message and stream now. CallSync does this before it sends.
+        /// </summary>
+        public static void FlushPendingMessages()
+        {
+            CommunicatorImplementation.Instance.FlushPendingMessages();
+        }
     }
 }
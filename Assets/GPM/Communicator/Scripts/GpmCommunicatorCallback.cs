@@ -3,5 +3,10 @@
     public class GpmCommunicatorCallback
     {
         public delegate void CommunicatorCallback(GpmCommunicatorVO.Message message);
+
+        /// <summary>
+        /// Called once, when the stream is done or aborted.
+        /// </summary>
+        public delegate void StreamCallback(GpmCommunicatorStream stream);
     }
 }
\ No newline at end of file
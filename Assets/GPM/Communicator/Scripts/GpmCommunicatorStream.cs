@@ -0,0 +1,52 @@
+﻿namespace Gpm.Communicator
+{
+    /// <summary>
+    /// A message sent in chunks over several frames. Lengths count characters of the data as sent, after compression.
+    /// </summary>
+    public class GpmCommunicatorStream
+    {
+        private volatile bool isAbortRequested;
+
+        /// <summary>
+        /// 0 until the data has been compressed.
+        /// </summary>
+        public int Length { get; internal set; }
+        public int SentLength { get; internal set; }
+        public bool IsDone { get; internal set; }
+
+        /// <summary>
+        /// True when Abort was called or the native plugin rejected a chunk. Native drops what it received.
+        /// </summary>
+        public bool IsAborted { get; internal set; }
+
+        public float Progress
+        {
+            get
+            {
+                if (IsDone == true)
+                {
+                    return 1f;
+                }
+
+                return (Length > 0) ? (float)SentLength / Length : 0f;
+            }
+        }
+
+        internal bool IsAbortRequested
+        {
+            get { return isAbortRequested; }
+        }
+
+        internal GpmCommunicatorStream()
+        {
+        }
+
+        /// <summary>
+        /// Takes effect on the next frame. Ignored once the stream is done.
+        /// </summary>
+        public void Abort()
+        {
+            isAbortRequested = true;
+        }
+    }
+}
\ No newline at end of file
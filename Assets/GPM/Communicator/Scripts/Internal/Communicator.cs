@@ -3,6 +3,8 @@
     using Gpm.Communicator.Internal.Log;
     using System;
     using System.Collections.Generic;
+    using System.Text;
+    using System.Threading.Tasks;
     using UnityEngine;
 
     public class Communicator : MonoBehaviour
@@ -11,7 +13,36 @@
         private string methodName = "OnAsyncEvent";
         private const string DELIMITER = "${gpm_communicator}";
 
-        private static Dictionary<string, GpmCommunicatorCallback.CommunicatorCallback> receiverDictionary = new Dictionary<string, GpmCommunicatorCallback.CommunicatorCallback>();
+        private class Receiver
+        {
+            public string topic;
+            public GpmCommunicatorCallback.CommunicatorCallback callback;
+        }
+
+        // Copy-on-write, so delivery iterates the array without copying it and a receiver added during delivery waits for the next message.
+        private static Dictionary<string, Receiver[]> receiverDictionary = new Dictionary<string, Receiver[]>();
+
+        private const int STREAM_THRESHOLD = 1024 * 1024;
+        private const int STREAM_CHUNK_LENGTH = 256 * 1024;
+        private const int STREAM_FRAME_LENGTH = 1024 * 1024;
+        private const int INVALID_STREAM_ID = -1;
+
+        /// <summary>
+        /// An async message waiting behind a stream. Only streams have a compressTask.
+        /// </summary>
+        private class PendingMessage
+        {
+            public string domain;
+            public string data;
+            public string extra;
+            public int byteCount;
+            public Task compressTask;
+            public int streamId = INVALID_STREAM_ID;
+            public GpmCommunicatorStream stream;
+            public GpmCommunicatorCallback.StreamCallback callback;
+        }
+
+        private Queue<PendingMessage> pendingMessages = new Queue<PendingMessage>();
 
         private Communicator()
         {
@@ -44,9 +75,26 @@
             messageSender.InitializeClass(configuration.className);
         }
 
-        public void AddReceiver(string domain, GpmCommunicatorCallback.CommunicatorCallback callback)
+        public void SetCompressionThreshold(int threshold)
         {
-            if(receiverDictionary.ContainsKey(domain) == true)
+            if (messageSender == null)
+            {
+                CommunicatorLogger.Error("MessageSender is null", "GpmCommunicator", GetType(), "SetCompressionThreshold");
+                return;
+            }
+
+            messageSender.SetCompressionThreshold(threshold);
+        }
+
+        public void AddReceiver(string domain, string topic, GpmCommunicatorCallback.CommunicatorCallback callback)
+        {
+            Receiver[] receivers;
+            if (receiverDictionary.TryGetValue(domain, out receivers) == false)
+            {
+                receivers = new Receiver[0];
+            }
+
+            if (Array.Exists(receivers, receiver => receiver.topic == topic && receiver.callback == callback) == true)
             {
                 CommunicatorLogger.Error(
                     string.Format(
@@ -58,7 +106,14 @@
                 return;
             }
 
-            receiverDictionary.Add(domain, callback);
+            var newReceivers = new Receiver[receivers.Length + 1];
+            Array.Copy(receivers, newReceivers, receivers.Length);
+            newReceivers[receivers.Length] = new Receiver()
+            {
+                topic = topic,
+                callback = callback
+            };
+            receiverDictionary[domain] = newReceivers;
         }
 
         public GpmCommunicatorVO.Message CallSync(GpmCommunicatorVO.Message message)
@@ -69,6 +124,8 @@
                 return null;
             }
 
+            FlushPendingMessages();
+
             string responseString = messageSender.CallSync(message.domain, message.data, message.extra);
 
             GpmCommunicatorVO.Message responseMessage = null;
@@ -87,7 +144,7 @@
 
             responseMessage = new GpmCommunicatorVO.Message();
             responseMessage.domain = messageData[0];
-            responseMessage.data = messageData[1];
+            responseMessage.data = messageSender.Decompress(messageData[1]);
             responseMessage.extra = messageData[2];
 
             return responseMessage;
@@ -101,9 +158,208 @@
                 return;
             }
 
+            if (messageSender.IsStreamSupported == true && message.data != null && message.data.Length > STREAM_THRESHOLD)
+            {
+                CallAsyncStream(message, null);
+                return;
+            }
+
+            if (pendingMessages.Count > 0)
+            {
+                pendingMessages.Enqueue(new PendingMessage()
+                {
+                    domain = message.domain,
+                    data = message.data,
+                    extra = message.extra
+                });
+                return;
+            }
+
             messageSender.CallAsync(message.domain, message.data, message.extra);
         }
 
+        public GpmCommunicatorStream CallAsyncStream(GpmCommunicatorVO.Message message, GpmCommunicatorCallback.StreamCallback callback)
+        {
+            if (messageSender == null)
+            {
+                CommunicatorLogger.Error("MessageSender is null", "GpmCommunicator", GetType(), "CallAsyncStream");
+                return null;
+            }
+
+            var pending = new PendingMessage()
+            {
+                domain = message.domain,
+                data = message.data,
+                extra = message.extra,
+                stream = new GpmCommunicatorStream(),
+                callback = callback
+            };
+
+            // Only the compressed copy is kept, the source stays with the caller's message.
+            INativeMessageSender sender = messageSender;
+            pending.compressTask = Task.Run(() =>
+            {
+                string source = pending.data;
+                pending.data = null;
+                pending.data = sender.Compress(source);
+                pending.byteCount = (pending.data != null) ? Encoding.UTF8.GetByteCount(pending.data) : 0;
+            });
+
+            pendingMessages.Enqueue(pending);
+
+            return pending.stream;
+        }
+
+        public void FlushPendingMessages()
+        {
+            PumpPendingMessages(int.MaxValue, true);
+        }
+
+        private void Update()
+        {
+            if (pendingMessages.Count > 0)
+            {
+                PumpPendingMessages(STREAM_FRAME_LENGTH, false);
+            }
+        }
+
+        /// <summary>
+        /// Sends queued messages in order until budget characters of stream data are sent.
+        /// </summary>
+        private void PumpPendingMessages(int budget, bool waitCompression)
+        {
+            while (pendingMessages.Count > 0)
+            {
+                PendingMessage pending = pendingMessages.Peek();
+
+                if (pending.stream == null)
+                {
+                    pendingMessages.Dequeue();
+                    messageSender.CallAsync(pending.domain, pending.data, pending.extra);
+                    continue;
+                }
+
+                if (pending.stream.IsAbortRequested == false && pending.compressTask.IsCompleted == false)
+                {
+                    if (waitCompression == false)
+                    {
+                        return;
+                    }
+
+                    ((IAsyncResult)pending.compressTask).AsyncWaitHandle.WaitOne();
+                }
+
+                if (PumpStream(pending, ref budget) == false)
+                {
+                    return;
+                }
+
+                pendingMessages.Dequeue();
+                if (pending.callback != null)
+                {
+                    pending.callback(pending.stream);
+                }
+            }
+        }
+
+        /// <summary>
+        /// Returns false while chunks remain after the budget is spent.
+        /// </summary>
+        private bool PumpStream(PendingMessage pending, ref int budget)
+        {
+            GpmCommunicatorStream stream = pending.stream;
+
+            if (stream.IsAbortRequested == true)
+            {
+                if (pending.streamId != INVALID_STREAM_ID)
+                {
+                    messageSender.AbortStream(pending.streamId);
+                }
+                stream.IsAborted = true;
+                return true;
+            }
+
+            if (pending.compressTask.IsFaulted == true)
+            {
+                CommunicatorLogger.Error(
+                    string.Format(
+                        "Failed to compress stream : {0}",
+                        pending.compressTask.Exception.GetBaseException().Message),
+                    "GpmCommunicator",
+                    GetType(),
+                    "PumpStream");
+                stream.IsAborted = true;
+                return true;
+            }
+
+            string data = pending.data;
+
+            if (pending.streamId == INVALID_STREAM_ID)
+            {
+                stream.Length = (data != null) ? data.Length : 0;
+
+                if (stream.Length > STREAM_THRESHOLD)
+                {
+                    pending.streamId = messageSender.BeginStream(pending.domain, pending.extra, pending.byteCount);
+
+                    if (pending.streamId == INVALID_STREAM_ID && messageSender.IsStreamSupported == true)
+                    {
+                        CommunicatorLogger.Warn(
+                            string.Format(
+                                "Failed to begin stream, sent in a single call : {0}",
+                                pending.domain),
+                            "GpmCommunicator",
+                            GetType(),
+                            "PumpStream");
+                    }
+                }
+
+                if (pending.streamId == INVALID_STREAM_ID)
+                {
+                    messageSender.CallAsyncCompressed(pending.domain, data, pending.extra);
+                    stream.SentLength = stream.Length;
+                    stream.IsDone = true;
+                    return true;
+                }
+            }
+
+            while (stream.SentLength < data.Length)
+            {
+                if (budget <= 0)
+                {
+                    return false;
+                }
+
+                int offset = stream.SentLength;
+                int length = Math.Min(STREAM_CHUNK_LENGTH, data.Length - offset);
+                if (offset + length < data.Length && char.IsHighSurrogate(data[offset + length - 1]) == true)
+                {
+                    length--;
+                }
+
+                if (messageSender.AppendStream(pending.streamId, data.Substring(offset, length)) == false)
+                {
+                    CommunicatorLogger.Error(
+                        string.Format(
+                            "Failed to append stream : {0}",
+                            pending.domain),
+                        "GpmCommunicator",
+                        GetType(),
+                        "PumpStream");
+                    messageSender.AbortStream(pending.streamId);
+                    stream.IsAborted = true;
+                    return true;
+                }
+
+                stream.SentLength = offset + length;
+                budget -= length;
+            }
+
+            messageSender.EndStream(pending.streamId);
+            stream.IsDone = true;
+            return true;
+        }
+
         public void OnAsyncEvent(string message)
         {
             string[] messageData = message.Split(new string[] { DELIMITER }, StringSplitOptions.None);
@@ -116,8 +372,10 @@
             string domain = messageData[0];
             string data = string.Empty;
             string extra = string.Empty;
+            string topic = null;
 
-            if (receiverDictionary.ContainsKey(domain) == false)
+            Receiver[] receivers;
+            if (receiverDictionary.TryGetValue(domain, out receivers) == false)
             {
                 CommunicatorLogger.Warn(
                     string.Format(
@@ -129,11 +387,9 @@
                 return;
             }
 
-            GpmCommunicatorCallback.CommunicatorCallback callback = receiverDictionary[domain];
-
             if(messageData.Length > 1)
             {
-                data = messageData[1];
+                data = (messageSender != null) ? messageSender.Decompress(messageData[1]) : messageData[1];
             }
 
             if(messageData.Length > 2)
@@ -141,12 +397,29 @@
                 extra = messageData[2];
             }
 
-            callback(new GpmCommunicatorVO.Message()
+            if (messageData.Length > 3)
+            {
+                topic = messageData[3];
+            }
+
+            // Decoded once, every receiver gets the same read-only message.
+            var receiveMessage = new GpmCommunicatorVO.Message()
             {
                 domain = domain,
                 data = data,
                 extra = extra
-            });
+            };
+            receiveMessage.SetReadOnly();
+
+            foreach (var receiver in receivers)
+            {
+                if (receiver.topic != null && receiver.topic != topic)
+                {
+                    continue;
+                }
+
+                receiver.callback(receiveMessage);
+            }
         }        
     }
 }
@@ -0,0 +1,162 @@
+﻿namespace Gpm.Communicator.Internal
+{
+    using Gpm.Communicator.Internal.Log;
+    using System;
+    using System.Globalization;
+    using System.IO;
+    using System.IO.Compression;
+    using System.Text;
+
+    /// <summary>
+    /// Frame : ${gpm_compress}[uncompressed byte length]:[base64 raw deflate]
+    /// Data that starts with the header but is sent as is becomes ${gpm_compress}:[data], so it is never read as a frame.
+    /// Raw deflate matches COMPRESSION_ZLIB on iOS.
+    /// Thresholds and lengths are in bytes of the UTF-8 encoded data, the same unit as the frame header.
+    /// </summary>
+    public static class CommunicatorCompressor
+    {
+        public const string HEADER = "${gpm_compress}";
+        public const int DEFAULT_THRESHOLD = 16 * 1024;
+        public const int MIN_THRESHOLD = 1024;
+        public const int MAX_LENGTH = 64 * 1024 * 1024;
+
+        private const char LENGTH_DELIMITER = ':';
+
+        /// <summary>
+        /// Returns data as it is sent: a compressed frame, or data itself, escaped when it starts with the header.
+        /// </summary>
+        public static string Compress(string data, int threshold)
+        {
+            if (data == null)
+            {
+                return data;
+            }
+
+            threshold = Math.Max(threshold, MIN_THRESHOLD);
+
+            // The UTF-8 length is at least the UTF-16 length and at most three times it, so most strings are decided without encoding.
+            if ((long)data.Length * 3 < threshold)
+            {
+                return Escape(data);
+            }
+
+            if (data.Length < threshold && Encoding.UTF8.GetByteCount(data) < threshold)
+            {
+                return Escape(data);
+            }
+
+            byte[] source = Encoding.UTF8.GetBytes(data);
+            if (source.Length > MAX_LENGTH)
+            {
+                return Escape(data);
+            }
+
+            using (var compressedStream = new MemoryStream(source.Length / 2))
+            {
+                using (var deflateStream = new DeflateStream(compressedStream, CompressionLevel.Fastest, true))
+                {
+                    deflateStream.Write(source, 0, source.Length);
+                }
+
+                // The frame is ASCII, so its length is also its byte count.
+                int frameLength = GetFrameLength(source.Length, compressedStream.Length);
+                if (frameLength >= source.Length)
+                {
+                    return Escape(data);
+                }
+
+                var builder = new StringBuilder(HEADER, frameLength);
+                builder.Append(source.Length);
+                builder.Append(LENGTH_DELIMITER);
+                builder.Append(Convert.ToBase64String(compressedStream.GetBuffer(), 0, (int)compressedStream.Length));
+
+                return builder.ToString();
+            }
+        }
+
+        /// <summary>
+        /// Returns null for a frame that does not decode.
+        /// </summary>
+        public static string Decompress(string data)
+        {
+            if (HasHeader(data) == false)
+            {
+                return data;
+            }
+
+            if (data.Length > HEADER.Length && data[HEADER.Length] == LENGTH_DELIMITER)
+            {
+                return data.Substring(HEADER.Length + 1);
+            }
+
+            int delimiterIndex = data.IndexOf(LENGTH_DELIMITER, HEADER.Length);
+            if (delimiterIndex < 0)
+            {
+                return null;
+            }
+
+            int length;
+            if (int.TryParse(data.Substring(HEADER.Length, delimiterIndex - HEADER.Length), NumberStyles.None, CultureInfo.InvariantCulture, out length) == false ||
+                length <= 0 || length > MAX_LENGTH)
+            {
+                CommunicatorLogger.Error(string.Format("Invalid length. max:{0}", MAX_LENGTH), "GpmCommunicator", typeof(CommunicatorCompressor), "Decompress");
+                return null;
+            }
+
+            byte[] decoded;
+            try
+            {
+                byte[] compressed = Convert.FromBase64String(data.Substring(delimiterIndex + 1));
+                decoded = new byte[length];
+
+                using (var deflateStream = new DeflateStream(new MemoryStream(compressed), CompressionMode.Decompress))
+                {
+                    int offset = 0;
+                    while (offset < length)
+                    {
+                        int read = deflateStream.Read(decoded, offset, length - offset);
+                        if (read <= 0)
+                        {
+                            CommunicatorLogger.Error(string.Format("Truncated data. length:{0}, read:{1}", length, offset), "GpmCommunicator", typeof(CommunicatorCompressor), "Decompress");
+                            return null;
+                        }
+                        offset += read;
+                    }
+                }
+            }
+            catch (FormatException e)
+            {
+                CommunicatorLogger.Error(string.Format("Invalid base64. {0}", e.Message), "GpmCommunicator", typeof(CommunicatorCompressor), "Decompress");
+                return null;
+            }
+            catch (InvalidDataException e)
+            {
+                CommunicatorLogger.Error(string.Format("Invalid deflate data. {0}", e.Message), "GpmCommunicator", typeof(CommunicatorCompressor), "Decompress");
+                return null;
+            }
+
+            return Encoding.UTF8.GetString(decoded);
+        }
+
+        private static bool HasHeader(string data)
+        {
+            return data != null && data.StartsWith(HEADER, StringComparison.Ordinal) == true;
+        }
+
+        private static string Escape(string data)
+        {
+            if (HasHeader(data) == false)
+            {
+                return data;
+            }
+
+            return HEADER + LENGTH_DELIMITER + data;
+        }
+
+        private static int GetFrameLength(int sourceLength, long compressedLength)
+        {
+            long base64Length = (compressedLength + 2) / 3 * 4;
+            return (int)Math.Min(HEADER.Length + sourceLength.ToString(CultureInfo.InvariantCulture).Length + 1 + base64Length, int.MaxValue);
+        }
+    }
+}
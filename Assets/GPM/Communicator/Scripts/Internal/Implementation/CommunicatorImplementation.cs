@@ -22,9 +22,14 @@
             communicator.InitializeClass(configuration);
         }
 
-        public void AddReceiver(string domain, GpmCommunicatorCallback.CommunicatorCallback callback)
+        public void SetCompressionThreshold(int threshold)
         {
-            communicator.AddReceiver(domain, callback);
+            communicator.SetCompressionThreshold(threshold);
+        }
+
+        public void AddReceiver(string domain, string topic, GpmCommunicatorCallback.CommunicatorCallback callback)
+        {
+            communicator.AddReceiver(domain, topic, callback);
         }
 
         public GpmCommunicatorVO.Message CallSync(GpmCommunicatorVO.Message message)
@@ -36,5 +41,15 @@
         {
             communicator.CallAsync(message);
         }
+
+        public GpmCommunicatorStream CallAsyncStream(GpmCommunicatorVO.Message message, GpmCommunicatorCallback.StreamCallback callback)
+        {
+            return communicator.CallAsyncStream(message, callback);
+        }
+
+        public void FlushPendingMessages()
+        {
+            communicator.FlushPendingMessages();
+        }
     }
 }
@@ -2,9 +2,31 @@
 {
     public interface INativeMessageSender
     {
+        bool IsStreamSupported { get; }
+
         void Initialize(string gameObjectName, string methodName);
         void InitializeClass(string className);
+        void SetCompressionThreshold(int threshold);
         string CallSync(string domain, string data, string extra);
         void CallAsync(string domain, string data, string extra);
+
+        /// <summary>
+        /// Thread-safe. Returns data as it is sent to native.
+        /// </summary>
+        string Compress(string data);
+
+        /// <summary>
+        /// Sends data returned by Compress without compressing it again.
+        /// </summary>
+        void CallAsyncCompressed(string domain, string data, string extra);
+
+        /// <summary>
+        /// Decodes data received from native. Returns null for a frame that does not decode.
+        /// </summary>
+        string Decompress(string data);
+        int BeginStream(string domain, string extra, int length);
+        bool AppendStream(int streamId, string chunk);
+        void EndStream(int streamId);
+        void AbortStream(int streamId);
     }
 }
\ No newline at end of file
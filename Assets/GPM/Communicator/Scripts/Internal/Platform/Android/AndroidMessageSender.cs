@@ -7,6 +7,7 @@ namespace Gpm.Communicator.Internal.Android
     {
         private static readonly AndroidMessageSender instance = new AndroidMessageSender();
         private const string GAMEBASE_ANDROID_PLUGIN_CLASS = "com.gpm.communicator.internal.MessageReceiver";
+        private const int INVALID_STREAM_ID = -1;
         private AndroidJavaClass jc = null;
 
         public static AndroidMessageSender Instance
@@ -14,6 +15,11 @@ namespace Gpm.Communicator.Internal.Android
             get { return instance; }
         }
 
+        public bool IsStreamSupported
+        {
+            get { return false; }
+        }
+
         private AndroidMessageSender()
         {
             if (jc == null)
@@ -32,6 +38,11 @@ namespace Gpm.Communicator.Internal.Android
             jc.CallStatic("initializeClass", className);
         }
 
+        public void SetCompressionThreshold(int threshold)
+        {
+            // The Android plugin does not decode compressed frames, so messages are always sent as is.
+        }
+
         public string CallSync(string domain, string data, string extra)
         {
             string retValue = jc.CallStatic<string>("onRequestSync", domain, data, extra);
@@ -43,6 +54,39 @@ namespace Gpm.Communicator.Internal.Android
         {
             jc.CallStatic("onRequestAsync", domain, data, extra);
         }
+
+        public string Compress(string data)
+        {
+            return data;
+        }
+
+        public void CallAsyncCompressed(string domain, string data, string extra)
+        {
+            CallAsync(domain, data, extra);
+        }
+
+        public string Decompress(string data)
+        {
+            return data;
+        }
+
+        public int BeginStream(string domain, string extra, int length)
+        {
+            return INVALID_STREAM_ID;
+        }
+
+        public bool AppendStream(int streamId, string chunk)
+        {
+            return false;
+        }
+
+        public void EndStream(int streamId)
+        {
+        }
+
+        public void AbortStream(int streamId)
+        {
+        }
     }
 }
 #endif
@@ -1,16 +1,24 @@
 ﻿#if UNITY_EDITOR || UNITY_IOS
 namespace Gpm.Communicator.Internal.Ios
 {
+    using System;
+
     public sealed class IosMessageSender : INativeMessageSender
     {
         private static readonly IosMessageSender instance = new IosMessageSender();
         private IosMessageSenderExtern iosMessageSenderExtern = new IosMessageSenderExtern();
+        private volatile int compressionThreshold = CommunicatorCompressor.DEFAULT_THRESHOLD;
 
         public static IosMessageSender Instance
         {
             get { return instance; }
         }
 
+        public bool IsStreamSupported
+        {
+            get { return true; }
+        }
+
         private IosMessageSender()
         {
             
@@ -26,15 +34,59 @@ namespace Gpm.Communicator.Internal.Ios
             iosMessageSenderExtern.InitializeClass(className);
         }
 
+        public void SetCompressionThreshold(int threshold)
+        {
+            compressionThreshold = Math.Max(threshold, CommunicatorCompressor.MIN_THRESHOLD);
+            iosMessageSenderExtern.SetCompressionThreshold(compressionThreshold);
+        }
+
         public string CallSync(string domain, string data, string extra)
         {
-            return iosMessageSenderExtern.CallSync(domain, data, extra);
+            return iosMessageSenderExtern.CallSync(domain, Compress(data), extra);
         }
 
         public void CallAsync(string domain, string data, string extra)
+        {
+            iosMessageSenderExtern.CallAsync(domain, Compress(data), extra);
+        }
+
+        public string Compress(string data)
+        {
+            return CommunicatorCompressor.Compress(data, compressionThreshold);
+        }
+
+        public void CallAsyncCompressed(string domain, string data, string extra)
         {
             iosMessageSenderExtern.CallAsync(domain, data, extra);
         }
+
+        public string Decompress(string data)
+        {
+            return CommunicatorCompressor.Decompress(data);
+        }
+
+        /// <summary>
+        /// Native reassembles the chunks into a single buffer, so no call marshals the whole payload at once.
+        /// </summary>
+        public int BeginStream(string domain, string extra, int length)
+        {
+            return iosMessageSenderExtern.BeginStream(domain, extra, length);
+        }
+
+        public bool AppendStream(int streamId, string chunk)
+        {
+            return iosMessageSenderExtern.AppendStream(streamId, chunk);
+        }
+
+        public void EndStream(int streamId)
+        {
+            iosMessageSenderExtern.EndStream(streamId);
+        }
+
+        public void AbortStream(int streamId)
+        {
+            iosMessageSenderExtern.AbortStream(streamId);
+        }
     }
 }
 #endif
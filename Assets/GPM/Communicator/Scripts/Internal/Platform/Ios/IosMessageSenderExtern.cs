@@ -11,9 +11,20 @@ namespace Gpm.Communicator.Internal.Ios
         [DllImport("__Internal")]
         private static extern void initializeClass(string className);
         [DllImport("__Internal")]
+        private static extern void setCompressionThreshold(int threshold);
+        [DllImport("__Internal")]
         private static extern IntPtr onRequestSync(string domain, string data, string extra);
         [DllImport("__Internal")]
         private static extern void onRequestAsync(string domain, string data, string extra);
+        [DllImport("__Internal")]
+        private static extern int beginRequestStream(string domain, string extra, int length);
+        [DllImport("__Internal")]
+        [return: MarshalAs(UnmanagedType.I1)]
+        private static extern bool appendRequestStream(int streamId, string chunk);
+        [DllImport("__Internal")]
+        private static extern void endRequestStream(int streamId);
+        [DllImport("__Internal")]
+        private static extern void abortRequestStream(int streamId);
 
         public void Initialize(string gameObjectName, string methodName)
         {
@@ -25,6 +36,11 @@ namespace Gpm.Communicator.Internal.Ios
             initializeClass(className);
         }
 
+        public void SetCompressionThreshold(int threshold)
+        {
+            setCompressionThreshold(threshold);
+        }
+
         public string CallSync(string domain, string data, string extra)
         {
             string retValue = string.Empty;
@@ -41,6 +57,26 @@ namespace Gpm.Communicator.Internal.Ios
         {
             onRequestAsync(domain, data, extra);
         }
+
+        public int BeginStream(string domain, string extra, int length)
+        {
+            return beginRequestStream(domain, extra, length);
+        }
+
+        public bool AppendStream(int streamId, string chunk)
+        {
+            return appendRequestStream(streamId, chunk);
+        }
+
+        public void EndStream(int streamId)
+        {
+            endRequestStream(streamId);
+        }
+
+        public void AbortStream(int streamId)
+        {
+            abortRequestStream(streamId);
+        }
     }
 }
 #endif
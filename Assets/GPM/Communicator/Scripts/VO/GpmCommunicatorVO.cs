@@ -7,11 +7,52 @@
             public string className;
         }
 
+        /// <summary>
+        /// Read-only once delivered to receivers, which all get the same instance.
+        /// Setters then throw InvalidOperationException.
+        /// </summary>
         public class Message
         {
-            public string domain;
-            public string data;
-            public string extra;
+            private string domainValue;
+            private string dataValue;
+            private string extraValue;
+            private bool isReadOnly;
+
+            public string domain
+            {
+                get { return domainValue; }
+                set { CheckWritable(); domainValue = value; }
+            }
+
+            public string data
+            {
+                get { return dataValue; }
+                set { CheckWritable(); dataValue = value; }
+            }
+
+            public string extra
+            {
+                get { return extraValue; }
+                set { CheckWritable(); extraValue = value; }
+            }
+
+            public bool IsReadOnly
+            {
+                get { return isReadOnly; }
+            }
+
+            internal void SetReadOnly()
+            {
+                isReadOnly = true;
+            }
+
+            private void CheckWritable()
+            {
+                if (isReadOnly == true)
+                {
+                    throw new System.InvalidOperationException("A received message is read-only");
+                }
+            }
         }
     }
 }
@@ -0,0 +1,36 @@
+#import <Foundation/Foundation.h>
+#import <GamePackageManagerWebView/GamePackageManagerWebView.h>
+#import "GPMWebViewStateSnapshot.h"
+
+// Presents the view of one webview instance. GPMWebViewPlugin creates a backend for each show and keeps it until
+// the backend reports GPMWebViewClose, or GPMWebViewOpen with an error.
+@protocol GPMWebViewBackend <NSObject>
+
+// YES when the backend presents one view for the whole app, so only one instance can be open at a time.
++ (BOOL)presentsSingleView;
+
+- (void)showWithURL:(NSString*)url configuration:(GPMWebViewConfiguration*)configuration schemeList:(NSArray*)schemeList callback:(GPMWebViewCallbackCompletion)callback;
+- (void)showWithHTMLFile:(NSString*)filePath configuration:(GPMWebViewConfiguration*)configuration schemeList:(NSArray*)schemeList callback:(GPMWebViewCallbackCompletion)callback;
+- (void)showWithHTMLString:(NSString*)htmlString configuration:(GPMWebViewConfiguration*)configuration schemeList:(NSArray*)schemeList callback:(GPMWebViewCallbackCompletion)callback;
+- (void)showSafeBrowsing:(NSString*)url configuration:(GPMSafeBrowsingConfiguration*)configuration callback:(GPMWebViewCallbackCompletion)callback;
+- (void)close;
+
+- (void)executeJavaScript:(NSString*)script;
+- (void)goBack;
+- (void)goForward;
+
+- (void)setPosition:(CGFloat)x y:(CGFloat)y;
+- (void)setSize:(CGFloat)width height:(CGFloat)height;
+- (void)setMargins:(CGFloat)left top:(CGFloat)top right:(CGFloat)right bottom:(CGFloat)bottom;
+
+// One value each, for the sync getters. state reads them all, to publish the snapshot.
+- (BOOL)isActive;
+- (BOOL)canGoBack;
+- (BOOL)canGoForward;
+- (int32_t)getX;
+- (int32_t)getY;
+- (int32_t)getWidth;
+- (int32_t)getHeight;
+- (GPMWebViewState)state;
+
+@end
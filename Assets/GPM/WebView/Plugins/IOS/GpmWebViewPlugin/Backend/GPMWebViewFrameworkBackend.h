@@ -0,0 +1,7 @@
+#import <Foundation/Foundation.h>
+#import "GPMWebViewBackend.h"
+
+// Presents the instance with GamePackageManagerWebView, which has a single view.
+@interface GPMWebViewFrameworkBackend : NSObject <GPMWebViewBackend>
+
+@end
@@ -0,0 +1,95 @@
+#import "GPMWebViewFrameworkBackend.h"
+
+@implementation GPMWebViewFrameworkBackend
+
++ (BOOL)presentsSingleView {
+    return YES;
+}
+
+- (void)showWithURL:(NSString*)url configuration:(GPMWebViewConfiguration*)configuration schemeList:(NSArray*)schemeList callback:(GPMWebViewCallbackCompletion)callback {
+    [GPMWebView showWithURL:url viewController:UnityGetGLViewController() configuration:configuration callbackCompletion:callback schemeList:schemeList];
+}
+
+- (void)showWithHTMLFile:(NSString*)filePath configuration:(GPMWebViewConfiguration*)configuration schemeList:(NSArray*)schemeList callback:(GPMWebViewCallbackCompletion)callback {
+    [GPMWebView showWithHTMLFile:filePath viewController:UnityGetGLViewController() configuration:configuration callbackCompletion:callback schemeList:schemeList];
+}
+
+- (void)showWithHTMLString:(NSString*)htmlString configuration:(GPMWebViewConfiguration*)configuration schemeList:(NSArray*)schemeList callback:(GPMWebViewCallbackCompletion)callback {
+    [GPMWebView showWithHTMLString:htmlString viewController:UnityGetGLViewController() configuration:configuration callbackCompletion:callback schemeList:schemeList];
+}
+
+- (void)showSafeBrowsing:(NSString*)url configuration:(GPMSafeBrowsingConfiguration*)configuration callback:(GPMWebViewCallbackCompletion)callback {
+    [GPMWebView showSafeBrowsing:url viewController:UnityGetGLViewController() configuration:configuration callbackCompletion:callback];
+}
+
+- (void)close {
+    [GPMWebView close];
+}
+
+- (void)executeJavaScript:(NSString*)script {
+    [GPMWebView executeJavaScriptWithScript:script];
+}
+
+- (void)goBack {
+    [GPMWebView goBack];
+}
+
+- (void)goForward {
+    [GPMWebView goForward];
+}
+
+- (void)setPosition:(CGFloat)x y:(CGFloat)y {
+    [GPMWebView setPosition:x y:y];
+}
+
+- (void)setSize:(CGFloat)width height:(CGFloat)height {
+    [GPMWebView setSize:width height:height];
+}
+
+- (void)setMargins:(CGFloat)left top:(CGFloat)top right:(CGFloat)right bottom:(CGFloat)bottom {
+    [GPMWebView setMargins:left top:top right:right bottom:bottom];
+}
+
+- (BOOL)isActive {
+    return [GPMWebView isActive];
+}
+
+- (BOOL)canGoBack {
+    return [GPMWebView canGoBack];
+}
+
+- (BOOL)canGoForward {
+    return [GPMWebView canGoForward];
+}
+
+- (int32_t)getX {
+    return (int32_t)[GPMWebView getX];
+}
+
+- (int32_t)getY {
+    return (int32_t)[GPMWebView getY];
+}
+
+- (int32_t)getWidth {
+    return (int32_t)[GPMWebView getWidth];
+}
+
+- (int32_t)getHeight {
+    return (int32_t)[GPMWebView getHeight];
+}
+
+- (GPMWebViewState)state {
+    GPMWebViewState state = {};
+    state.isActive = [self isActive];
+    if(state.isActive) {
+        state.canGoBack = [self canGoBack];
+        state.canGoForward = [self canGoForward];
+        state.x = [self getX];
+        state.y = [self getY];
+        state.width = [self getWidth];
+        state.height = [self getHeight];
+    }
+    return state;
+}
+
+@end
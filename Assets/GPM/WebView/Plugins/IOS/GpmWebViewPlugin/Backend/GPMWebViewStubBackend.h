@@ -0,0 +1,8 @@
+#import <Foundation/Foundation.h>
+#import "GPMWebViewBackend.h"
+
+// Headless backend without a view. Every instance can be open at once; show, navigation and close are reported
+// synchronously and geometry is kept in memory. Used to drive the plugin where no view can be presented.
+@interface GPMWebViewStubBackend : NSObject <GPMWebViewBackend>
+
+@end
@@ -0,0 +1,118 @@
+#import "GPMWebViewStubBackend.h"
+#import "GPMWebViewStubView.h"
+
+typedef gpm::WebViewStubView<GPMWebViewState> GPMWebViewStubView;
+
+// The view logic is in GPMWebViewStubView.h, shared with the host tests. This adds the callbacks.
+@implementation GPMWebViewStubBackend {
+    GPMWebViewStubView _view;
+    GPMWebViewCallbackCompletion _callback;
+}
+
++ (BOOL)presentsSingleView {
+    return NO;
+}
+
+- (void)showWithURL:(NSString*)url configuration:(GPMWebViewConfiguration*)configuration schemeList:(NSArray*)schemeList callback:(GPMWebViewCallbackCompletion)callback {
+    [self showWithPage:url configuration:configuration callback:callback];
+}
+
+- (void)showWithHTMLFile:(NSString*)filePath configuration:(GPMWebViewConfiguration*)configuration schemeList:(NSArray*)schemeList callback:(GPMWebViewCallbackCompletion)callback {
+    [self showWithPage:filePath configuration:configuration callback:callback];
+}
+
+- (void)showWithHTMLString:(NSString*)htmlString configuration:(GPMWebViewConfiguration*)configuration schemeList:(NSArray*)schemeList callback:(GPMWebViewCallbackCompletion)callback {
+    [self showWithPage:nil configuration:configuration callback:callback];
+}
+
+- (void)showSafeBrowsing:(NSString*)url configuration:(GPMSafeBrowsingConfiguration*)configuration callback:(GPMWebViewCallbackCompletion)callback {
+    [self showWithPage:url configuration:nil callback:callback];
+}
+
+- (void)showWithPage:(NSString*)page configuration:(GPMWebViewConfiguration*)configuration callback:(GPMWebViewCallbackCompletion)callback {
+    GPMWebViewStubView::Geometry geometry;
+    if(configuration != nil) {
+        geometry.hasPosition = configuration.hasPosition == YES;
+        geometry.x = (int32_t)configuration.positionX;
+        geometry.y = (int32_t)configuration.positionY;
+        geometry.hasSize = configuration.hasSize == YES;
+        geometry.width = (int32_t)configuration.sizeWidth;
+        geometry.height = (int32_t)configuration.sizeHeight;
+    }
+    
+    if(_view.show(geometry) == false) {
+        callback(GPMWebViewOpen, nil, [GPMWebViewError resultWithCode:GPM_WEBVIEW_ERROR_ALREADY_OPEN message:@"The stub webview is already open."]);
+        return;
+    }
+    
+    _callback = [callback copy];
+    callback(GPMWebViewOpen, nil, nil);
+    callback(GPMWebViewPageLoad, page, nil);
+}
+
+- (void)close {
+    if(_view.close() == false) {
+        return;
+    }
+    
+    GPMWebViewCallbackCompletion callback = _callback;
+    _callback = nil;
+    callback(GPMWebViewClose, nil, nil);
+}
+
+// A stub view does not run scripts.
+- (void)executeJavaScript:(NSString*)script {
+}
+
+// A stub view holds a single page, so there is no history to move through.
+- (void)goBack {
+}
+
+- (void)goForward {
+}
+
+- (void)setPosition:(CGFloat)x y:(CGFloat)y {
+    _view.setPosition((int32_t)x, (int32_t)y);
+}
+
+- (void)setSize:(CGFloat)width height:(CGFloat)height {
+    _view.setSize((int32_t)width, (int32_t)height);
+}
+
+- (void)setMargins:(CGFloat)left top:(CGFloat)top right:(CGFloat)right bottom:(CGFloat)bottom {
+    _view.setMargins((int32_t)left, (int32_t)top);
+}
+
+- (BOOL)isActive {
+    return _view.state().isActive != 0;
+}
+
+- (BOOL)canGoBack {
+    return _view.state().canGoBack != 0;
+}
+
+- (BOOL)canGoForward {
+    return _view.state().canGoForward != 0;
+}
+
+- (int32_t)getX {
+    return _view.state().x;
+}
+
+- (int32_t)getY {
+    return _view.state().y;
+}
+
+- (int32_t)getWidth {
+    return _view.state().width;
+}
+
+- (int32_t)getHeight {
+    return _view.state().height;
+}
+
+- (GPMWebViewState)state {
+    return _view.state();
+}
+
+@end
@@ -1,5 +1,11 @@
 #import <Foundation/Foundation.h>
 
+#define GPM_WEBVIEW_DOMAIN @"GPM_WEBVIEW"
+
 @interface GPMWebViewPlugin: NSObject
 
+// Class of the GPMWebViewBackend created for each shown instance. GPMWebViewFrameworkBackend unless
+// GPM_WEBVIEW_STUB_BACKEND is defined. Set it before the first webview message, the plugin reads it once.
++ (void)setBackendClass:(Class)backendClass;
+
 @end
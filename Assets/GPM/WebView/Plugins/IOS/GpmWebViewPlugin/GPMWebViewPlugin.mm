@@ -4,10 +4,14 @@
 #import "GPMCommunicatorReceiver.h"
 #import "GPMWebViewMessage.h"
 #import "GPMWebViewJsonUtil.h"
+#import "GPMWebViewStateSnapshot.h"
 #import "GPMCommunicatorMessage.h"
+#import "GPMWebViewBackend.h"
+#import "GPMWebViewFrameworkBackend.h"
+#import "GPMWebViewStubBackend.h"
+#import "GPMWebViewRequestRouter.h"
 
 
-#define GPM_WEBVIEW_DOMAIN @"GPM_WEBVIEW"
 #define GPM_WEBVIEW_API_SHOW_URL @"gpmwebview://showUrl"
 #define GPM_WEBVIEW_API_SHOW_HTML_FILE @"gpmwebview://showHtmlFile"
 #define GPM_WEBVIEW_API_SHOW_HTML_STRING @"gpmwebview://showHtmlString"
@@ -29,15 +33,47 @@
 #define GPM_WEBVIEW_API_GET_HEIGHT @"gpmwebview://getHeight"
 #define GPM_WEBVIEW_API_SHOW_WEB_BROWSER @"gpmwebview://showWebBrowser"
 
-#define GPM_WEBVIEW_WEBVIEW_CALLBACK @"gpmwebview://webViewCallback";
+#define GPM_WEBVIEW_WEBVIEW_CALLBACK @"gpmwebview://webViewCallback"
 
-@implementation GPMWebViewPlugin
+// Sent for a request to an instance that is not open, as GPMWebViewRequestRouter decides. data is the scheme of the request.
+#define GPM_WEBVIEW_CALLBACK_REQUEST_FAILED 100
+#define GPM_WEBVIEW_NO_CALLBACK -1
+
+typedef gpm::WebViewRequestRouter<id<GPMWebViewBackend>, GPM_WEBVIEW_MAX_INSTANCE_COUNT> GPMWebViewRequestRouter;
+
+static Class<GPMWebViewBackend> gpmWebViewBackendClass = nil;
+
+GPM_COMMUNICATOR_REGISTER_PLUGIN(GPM_WEBVIEW_DOMAIN, GPMWebViewPlugin)
+
+// Every message carries an instanceId. Each instance has its own state snapshot and its own dispatch session,
+// so closing one drops only its pending work. A show opens the instance in _router with a new backend,
+// and the close callback of that backend closes it. A backend with a single view lets one instance be open at a time.
+// A refused show is answered with an ALREADY_OPEN open callback, and _router decides which other requests
+// get GPM_WEBVIEW_CALLBACK_REQUEST_FAILED. Callbacks go out under a topic per instance.
+@implementation GPMWebViewPlugin {
+    Class<GPMWebViewBackend> _backendClass;
+    GPMWebViewRequestRouter* _router;
+}
+
++ (void)setBackendClass:(Class)backendClass {
+    gpmWebViewBackendClass = backendClass;
+}
 
 - (id)init {
     if((self = [super init]) == nil) {
         return nil;
     }
     
+#ifdef GPM_WEBVIEW_STUB_BACKEND
+    _backendClass = [GPMWebViewStubBackend class];
+#else
+    _backendClass = [GPMWebViewFrameworkBackend class];
+#endif
+    if(gpmWebViewBackendClass != nil) {
+        _backendClass = gpmWebViewBackendClass;
+    }
+    _router = new GPMWebViewRequestRouter([_backendClass presentsSingleView] == YES);
+    
     GPMCommunicatorReceiver* receiver = [[GPMCommunicatorReceiver alloc] init];
     
     receiver.onRequestMessageSync = ^GPMCommunicatorMessage*(GPMCommunicatorMessage *message) {
@@ -48,66 +84,148 @@
         [self onAsyncMessage:message];
     };
     
+    receiver.onPrepareMessageAsync = ^(GPMCommunicatorMessage *message) {
+        [self onPrepareAsyncMessage:message];
+    };
+    
     [[GPMCommunicatorPlugin sharedGPMCommunicatorPlugin] addReceiverWithDomain:GPM_WEBVIEW_DOMAIN receiver:receiver];
     return self;
 }
 
+- (void)dealloc {
+    delete _router;
+}
+
+// Each getter asks the backend for its one value. An instance that is not open has a nil backend, which answers NO and 0.
 - (GPMCommunicatorMessage*)onSyncMessage: (GPMCommunicatorMessage*)message {
     GPMWebViewMessage* webviewMessage = [[GPMWebViewMessage alloc]initWithJsonString:message.data];
     GPMCommunicatorMessage* returnMessage = nil;
+    GPMWebViewRequestRouter::Entry entry;
+    
+    _router->find(webviewMessage.instanceId, entry);
+    id<GPMWebViewBackend> backend = entry.backend;
     
     if([webviewMessage.scheme isEqualToString:GPM_WEBVIEW_API_CAN_GO_BACK]) {
-        returnMessage = [self getBoolMessage:[GPMWebView canGoBack]];
+        returnMessage = [self getBoolMessage:[backend canGoBack]];
     } else if([webviewMessage.scheme isEqualToString:GPM_WEBVIEW_API_CAN_GO_FORWARD]) {
-        returnMessage = [self getBoolMessage:[GPMWebView canGoForward]];
+        returnMessage = [self getBoolMessage:[backend canGoForward]];
     } else if([webviewMessage.scheme isEqualToString:GPM_WEBVIEW_API_IS_ACTIVE]) {
-        returnMessage = [self getBoolMessage:[GPMWebView isActive]];
+        returnMessage = [self getBoolMessage:[backend isActive]];
     } else if([webviewMessage.scheme isEqualToString:GPM_WEBVIEW_API_GET_X]) {
-        returnMessage = [self getIntMessage:[GPMWebView getX]];
+        returnMessage = [self getIntMessage:[backend getX]];
     } else if([webviewMessage.scheme isEqualToString:GPM_WEBVIEW_API_GET_Y]) {
-        returnMessage = [self getIntMessage:[GPMWebView getY]];
+        returnMessage = [self getIntMessage:[backend getY]];
     } else if([webviewMessage.scheme isEqualToString:GPM_WEBVIEW_API_GET_WIDTH]) {
-        returnMessage = [self getIntMessage:[GPMWebView getWidth]];
+        returnMessage = [self getIntMessage:[backend getWidth]];
     } else if([webviewMessage.scheme isEqualToString:GPM_WEBVIEW_API_GET_HEIGHT]) {
-        returnMessage = [self getIntMessage:[GPMWebView getHeight]];
+        returnMessage = [self getIntMessage:[backend getHeight]];
     }
     
     return returnMessage;
 }
 
+// Runs on the calling thread for every async message, so only the small header in extra is parsed here.
+// data, which can hold a whole HTML document, is parsed when the message is handled.
+- (void)onPrepareAsyncMessage: (GPMCommunicatorMessage*)message {
+    if(message.extra == nil) {
+        return;
+    }
+    
+    GPMWebViewMessage* header = [[GPMWebViewMessage alloc]initWithJsonString:message.extra];
+    message.topic = header.scheme;
+    message.session = [NSString stringWithFormat:@"%@/%ld", GPM_WEBVIEW_DOMAIN, (long)header.instanceId];
+    
+    if([header.scheme isEqualToString:GPM_WEBVIEW_API_CLOSE]) {
+        message.priority = GPMCommunicatorMessagePriorityControl;
+        message.endsSession = YES;
+    } else if([header.scheme isEqualToString:GPM_WEBVIEW_API_GO_BACK] ||
+              [header.scheme isEqualToString:GPM_WEBVIEW_API_GO_FORWARD]) {
+        message.priority = GPMCommunicatorMessagePriorityControl;
+    }
+}
+
 - (void)onAsyncMessage: (GPMCommunicatorMessage*)message {
     GPMWebViewMessage* webviewMessage = [[GPMWebViewMessage alloc]initWithJsonString:message.data];
+    GPMWebViewRequestRouter::RequestKind kind = [self requestKindWithScheme:webviewMessage.scheme];
+    
+    GPMWebViewRequestRouter::Entry entry;
+    if(kind == GPMWebViewRequestRouter::SHOW) {
+        entry.backend = [[(Class)_backendClass alloc] init];
+        entry.callback = webviewMessage.callback;
+    }
     
-    if([webviewMessage.scheme isEqualToString:GPM_WEBVIEW_API_SHOW_URL]) {
-        [self showUrl:webviewMessage];
-    } else if([webviewMessage.scheme isEqualToString:GPM_WEBVIEW_API_SHOW_HTML_FILE]) {
-        [self showHtmlFile:webviewMessage];
-    } else if([webviewMessage.scheme isEqualToString:GPM_WEBVIEW_API_SHOW_HTML_STRING]) {
-        [self showHtmlString:webviewMessage];
-    } else if([webviewMessage.scheme isEqualToString:GPM_WEBVIEW_API_SHOW_SAFE_BROWSING]) {
-        [self showSafeBrowsing:webviewMessage];
-    } else if([webviewMessage.scheme isEqualToString:GPM_WEBVIEW_API_CLOSE]) {
-        [self close];
+    switch(_router->route(webviewMessage.instanceId, kind, entry)) {
+        case GPMWebViewRequestRouter::DROP:
+            NSLog(@"%@ : %ld", @"Invalid webview instance", (long)webviewMessage.instanceId);
+            break;
+        case GPMWebViewRequestRouter::OPEN:
+            [self showWithMessage:webviewMessage backend:entry.backend];
+            break;
+        case GPMWebViewRequestRouter::REFUSE_ALREADY_OPEN:
+            [self sendAlreadyOpenWithMessage:webviewMessage reason:@"The webview instance is already open."];
+            break;
+        case GPMWebViewRequestRouter::REFUSE_VIEW_IN_USE:
+            [self sendAlreadyOpenWithMessage:webviewMessage reason:@"Another webview instance holds the view."];
+            break;
+        case GPMWebViewRequestRouter::SERVE_APP:
+            if([webviewMessage.scheme isEqualToString:GPM_WEBVIEW_API_SET_FILE_DOWNLOAD_PATH]) {
+                [self setFileDownloadPath:webviewMessage];
+            } else if([webviewMessage.scheme isEqualToString:GPM_WEBVIEW_API_SHOW_WEB_BROWSER]) {
+                [self showWebBrowser:webviewMessage];
+            }
+            break;
+        case GPMWebViewRequestRouter::SERVE_BACKEND:
+            [self handleMessage:webviewMessage backend:entry.backend];
+            break;
+        case GPMWebViewRequestRouter::FAIL:
+            [self sendRequestFailedWithMessage:webviewMessage];
+            break;
+        default:
+            break;
+    }
+}
+
+- (void)handleMessage:(GPMWebViewMessage*)webviewMessage backend:(id<GPMWebViewBackend>)backend {
+    if([webviewMessage.scheme isEqualToString:GPM_WEBVIEW_API_CLOSE]) {
+        [backend close];
     } else if([webviewMessage.scheme isEqualToString:GPM_WEBVIEW_API_EXECUTE_JAVASCRIPT]) {
-        [self executeJavaScript:webviewMessage];
-    } else if([webviewMessage.scheme isEqualToString:GPM_WEBVIEW_API_SET_FILE_DOWNLOAD_PATH]) {
-        [self setFileDownloadPath:webviewMessage];
+        [self executeJavaScript:webviewMessage backend:backend];
     } else if([webviewMessage.scheme isEqualToString:GPM_WEBVIEW_API_GO_BACK]) {
-        [self goBack];
+        [backend goBack];
     } else if([webviewMessage.scheme isEqualToString:GPM_WEBVIEW_API_GO_FORWARD]) {
-        [self goForward];
+        [backend goForward];
     } else if([webviewMessage.scheme isEqualToString:GPM_WEBVIEW_API_SET_POSITION]) {
-        [self setPosition:webviewMessage];
+        [self setPosition:webviewMessage backend:backend];
     } else if([webviewMessage.scheme isEqualToString:GPM_WEBVIEW_API_SET_SIZE]) {
-        [self setSize:webviewMessage];
+        [self setSize:webviewMessage backend:backend];
     } else if([webviewMessage.scheme isEqualToString:GPM_WEBVIEW_API_SET_MARGINS]) {
-        [self setMargins:webviewMessage];
-    } else if([webviewMessage.scheme isEqualToString:GPM_WEBVIEW_API_SHOW_WEB_BROWSER]) {
-        [self showWebBrowser:webviewMessage];
+        [self setMargins:webviewMessage backend:backend];
+    }
+}
+
+// The instance was opened with backend.
+- (void)showWithMessage:(GPMWebViewMessage*)webViewMessage backend:(id<GPMWebViewBackend>)backend {
+    NSInteger instanceId = webViewMessage.instanceId;
+    NSInteger callback = webViewMessage.callback;
+    
+    // Weak, since the backend keeps the completion until it closes.
+    __weak id<GPMWebViewBackend> weakBackend = backend;
+    GPMWebViewCallbackCompletion completion = ^(NSInteger callbackType, NSString *data, GPMWebViewError *error) {
+        [self onCallbackWithBackend:weakBackend callback:callback instanceId:instanceId callbackType:callbackType data:data error:error];
+    };
+    
+    if([webViewMessage.scheme isEqualToString:GPM_WEBVIEW_API_SHOW_URL]) {
+        [self showUrl:webViewMessage backend:backend completion:completion];
+    } else if([webViewMessage.scheme isEqualToString:GPM_WEBVIEW_API_SHOW_HTML_FILE]) {
+        [self showHtmlFile:webViewMessage backend:backend completion:completion];
+    } else if([webViewMessage.scheme isEqualToString:GPM_WEBVIEW_API_SHOW_HTML_STRING]) {
+        [self showHtmlString:webViewMessage backend:backend completion:completion];
+    } else if([webViewMessage.scheme isEqualToString:GPM_WEBVIEW_API_SHOW_SAFE_BROWSING]) {
+        [self showSafeBrowsing:webViewMessage backend:backend completion:completion];
     }
 }
 
-- (void)showUrl:(GPMWebViewMessage*)webViewMessage {
+- (void)showUrl:(GPMWebViewMessage*)webViewMessage backend:(id<GPMWebViewBackend>)backend completion:(GPMWebViewCallbackCompletion)completion {
     NSDictionary* dataDic = [webViewMessage.data JSONDictionary];
     
     NSString* url = dataDic[@"data"];
@@ -115,12 +233,10 @@
     NSDictionary* configurationDic = dataDic[@"configuration"];
     GPMWebViewConfiguration* configuration = [self getConfiguration:configurationDic];
     
-    [GPMWebView showWithURL:url viewController:UnityGetGLViewController() configuration:configuration callbackCompletion:^(NSInteger callbackType, NSString *data, GPMWebViewError *error) {
-        [self sendWebViewMessage:webViewMessage.callback callbackType:callbackType data:data error:error];
-    } schemeList:schemeArray];
+    [backend showWithURL:url configuration:configuration schemeList:schemeArray callback:completion];
 }
 
-- (void) showHtmlFile: (GPMWebViewMessage*)webViewMessage {
+- (void) showHtmlFile: (GPMWebViewMessage*)webViewMessage backend:(id<GPMWebViewBackend>)backend completion:(GPMWebViewCallbackCompletion)completion {
     NSDictionary* dataDic = [webViewMessage.data JSONDictionary];
     
     NSString* filePath = dataDic[@"data"];
@@ -128,12 +244,10 @@
     NSDictionary* configurationDic = dataDic[@"configuration"];
     GPMWebViewConfiguration* configuration = [self getConfiguration:configurationDic];
     
-    [GPMWebView showWithHTMLFile:filePath viewController:UnityGetGLViewController() configuration:configuration callbackCompletion:^(NSInteger callbackType, NSString *data, GPMWebViewError *error) {
-        [self sendWebViewMessage:webViewMessage.callback callbackType:callbackType data:data error:error];
-    } schemeList:schemeArray];
+    [backend showWithHTMLFile:filePath configuration:configuration schemeList:schemeArray callback:completion];
 }
 
-- (void) showHtmlString: (GPMWebViewMessage*)webViewMessage {
+- (void) showHtmlString: (GPMWebViewMessage*)webViewMessage backend:(id<GPMWebViewBackend>)backend completion:(GPMWebViewCallbackCompletion)completion {
     NSDictionary* dataDic = [webViewMessage.data JSONDictionary];
     
     NSString* htmlString = dataDic[@"data"];
@@ -141,80 +255,57 @@
     NSDictionary* configurationDic = dataDic[@"configuration"];
     GPMWebViewConfiguration* configuration = [self getConfiguration:configurationDic];
     
-    [GPMWebView showWithHTMLString:htmlString viewController:UnityGetGLViewController() configuration:configuration callbackCompletion:^(NSInteger callbackType, NSString *data, GPMWebViewError *error) {
-        [self sendWebViewMessage:webViewMessage.callback callbackType:callbackType data:data error:error];
-    } schemeList:schemeArray];
+    [backend showWithHTMLString:htmlString configuration:configuration schemeList:schemeArray callback:completion];
 }
 
-- (void) showSafeBrowsing: (GPMWebViewMessage*)webViewMessage {
+- (void) showSafeBrowsing: (GPMWebViewMessage*)webViewMessage backend:(id<GPMWebViewBackend>)backend completion:(GPMWebViewCallbackCompletion)completion {
     NSDictionary *dataDic = [webViewMessage.data JSONDictionary];
     
     NSString *url = dataDic[@"url"];
     NSDictionary *configurationDic = dataDic[@"configuration"];
     GPMSafeBrowsingConfiguration *configuration = [self getSafeBrowsingConfiguration:configurationDic];
     
-    [GPMWebView showSafeBrowsing:url viewController:UnityGetGLViewController() configuration:configuration callbackCompletion:^(NSInteger callbackType, NSString *data, GPMWebViewError *error) {
-        [self sendWebViewMessage:webViewMessage.callback callbackType:callbackType data:data error:error];
-    }];
+    [backend showSafeBrowsing:url configuration:configuration callback:completion];
 }
 
-- (void) executeJavaScript: (GPMWebViewMessage*)webViewMessage {
+- (void) executeJavaScript: (GPMWebViewMessage*)webViewMessage backend:(id<GPMWebViewBackend>)backend {
     NSDictionary* dataDic = [webViewMessage.data JSONDictionary];
     NSString* script = dataDic[@"script"];
     
-    [GPMWebView executeJavaScriptWithScript:script];
-}
-
-- (void) close {
-    [GPMWebView close];
-}
-
-- (GPMCommunicatorMessage*) isActive {
-    BOOL result = [GPMWebView isActive];
-    
-    GPMCommunicatorMessage* message = [[GPMCommunicatorMessage alloc] init];
-    message.domain = GPM_WEBVIEW_DOMAIN;
-    message.data = result ? @"true" : @"false";
-    
-    return message;
+    [backend executeJavaScript:script];
 }
 
 - (void) setFileDownloadPath: (GPMWebViewMessage*)webViewMessage {
     
 }
 
-- (void) goBack {
-    [GPMWebView goForward];
-}
-
-- (void) goForward {
-    [GPMWebView goForward];
-}
-
-- (void)setPosition: (GPMWebViewMessage*)webViewMessage {
+- (void)setPosition: (GPMWebViewMessage*)webViewMessage backend:(id<GPMWebViewBackend>)backend {
     NSDictionary* dataDic = [webViewMessage.data JSONDictionary];
     CGFloat x = (CGFloat)[dataDic[@"x"] intValue];
     CGFloat y = (CGFloat)[dataDic[@"y"] intValue];
     
-    [GPMWebView setPosition:x y:y];
+    [backend setPosition:x y:y];
+    [self publishStateWithInstanceId:webViewMessage.instanceId backend:backend];
 }
 
-- (void)setSize: (GPMWebViewMessage*)webViewMessage {
+- (void)setSize: (GPMWebViewMessage*)webViewMessage backend:(id<GPMWebViewBackend>)backend {
     NSDictionary* dataDic = [webViewMessage.data JSONDictionary];
     CGFloat width = (CGFloat)[dataDic[@"width"] intValue];
     CGFloat height = (CGFloat)[dataDic[@"height"] intValue];
     
-    [GPMWebView setSize:width height:height];
+    [backend setSize:width height:height];
+    [self publishStateWithInstanceId:webViewMessage.instanceId backend:backend];
 }
 
-- (void)setMargins: (GPMWebViewMessage*)webViewMessage {
+- (void)setMargins: (GPMWebViewMessage*)webViewMessage backend:(id<GPMWebViewBackend>)backend {
     NSDictionary* dataDic = [webViewMessage.data JSONDictionary];
     CGFloat left = (CGFloat)[dataDic[@"left"] intValue];
     CGFloat top = (CGFloat)[dataDic[@"top"] intValue];
     CGFloat right = (CGFloat)[dataDic[@"right"] intValue];
     CGFloat bottom = (CGFloat)[dataDic[@"bottom"] intValue];
     
-    [GPMWebView setMargins:left top:top right:right bottom:bottom];
+    [backend setMargins:left top:top right:right bottom:bottom];
+    [self publishStateWithInstanceId:webViewMessage.instanceId backend:backend];
 }
 
 - (void) showWebBrowser: (GPMWebViewMessage*)webViewMessage {
@@ -273,11 +364,53 @@
     return nil;
 }
 
-- (void) sendWebViewMessage:(NSInteger)callback callbackType:(NSInteger)callbackType data:(NSString *)data error:(GPMWebViewError *)error {
+// A backend reports for the instance it was created for. Once the instance is closed, the table no longer holds
+// that backend, so late callbacks of the closed view are passed on without touching the instance opened after it.
+- (void)onCallbackWithBackend:(id<GPMWebViewBackend>)backend callback:(NSInteger)callback instanceId:(NSInteger)instanceId callbackType:(NSInteger)callbackType data:(NSString *)data error:(GPMWebViewError *)error {
+    switch (callbackType) {
+        case GPMWebViewOpen:
+            if(error != nil) {
+                // The open failed, the instance never got the view.
+                _router->close(instanceId, backend);
+                break;
+            }
+            [self publishStateWithInstanceId:instanceId backend:backend];
+            break;
+        case GPMWebViewPageStarted:
+        case GPMWebViewPageLoad:
+        case GPMWebViewGoBack:
+        case GPMWebViewGoForward:
+            [self publishStateWithInstanceId:instanceId backend:backend];
+            break;
+        case GPMWebViewClose:
+            if(_router->close(instanceId, backend) == true) {
+                [[GPMWebViewStateSnapshot snapshotWithInstanceId:instanceId] publishState:GPMWebViewState()];
+            }
+            break;
+        default:
+            break;
+    }
+    
+    [self sendCallback:callback instanceId:instanceId callbackType:callbackType data:data error:error];
+}
+
+- (void)sendAlreadyOpenWithMessage:(GPMWebViewMessage*)webViewMessage reason:(NSString*)reason {
+    GPMWebViewError* error = [GPMWebViewError resultWithCode:GPM_WEBVIEW_ERROR_ALREADY_OPEN message:reason];
+    [self sendCallback:webViewMessage.callback instanceId:webViewMessage.instanceId callbackType:GPMWebViewOpen data:nil error:error];
+}
+
+// The instance has no view to serve the request. Answered, so the caller is not left waiting for it.
+- (void)sendRequestFailedWithMessage:(GPMWebViewMessage*)webViewMessage {
+    GPMWebViewError* error = [GPMWebViewError resultWithCode:GPM_WEBVIEW_ERROR_INVALID_PARAMETER message:@"The webview instance is not open."];
+    [self sendCallback:GPM_WEBVIEW_NO_CALLBACK instanceId:webViewMessage.instanceId callbackType:GPM_WEBVIEW_CALLBACK_REQUEST_FAILED data:webViewMessage.scheme error:error];
+}
+
+- (void) sendCallback:(NSInteger)callback instanceId:(NSInteger)instanceId callbackType:(NSInteger)callbackType data:(NSString *)data error:(GPMWebViewError *)error {
     GPMWebViewMessage* requestMessage = [[GPMWebViewMessage alloc] init];
     requestMessage.scheme = GPM_WEBVIEW_WEBVIEW_CALLBACK;
     requestMessage.callback = callback;
     requestMessage.callbackType = callbackType;
+    requestMessage.instanceId = instanceId;
     requestMessage.data = data;
     requestMessage.extra = nil;
     if (error != nil) {
@@ -287,10 +420,36 @@
     GPMCommunicatorMessage* message = [[GPMCommunicatorMessage alloc] init];
     message.domain = GPM_WEBVIEW_DOMAIN;
     message.data = [requestMessage toJsonString];
+    message.topic = [NSString stringWithFormat:@"%@/%ld", GPM_WEBVIEW_WEBVIEW_CALLBACK, (long)instanceId];
     
     [[GPMCommunicatorPlugin sharedGPMCommunicatorPlugin] sendResponseWithMessage:message];
 }
 
+- (GPMWebViewRequestRouter::RequestKind)requestKindWithScheme:(NSString*)scheme {
+    if([scheme isEqualToString:GPM_WEBVIEW_API_SHOW_URL] ||
+       [scheme isEqualToString:GPM_WEBVIEW_API_SHOW_HTML_FILE] ||
+       [scheme isEqualToString:GPM_WEBVIEW_API_SHOW_HTML_STRING] ||
+       [scheme isEqualToString:GPM_WEBVIEW_API_SHOW_SAFE_BROWSING]) {
+        return GPMWebViewRequestRouter::SHOW;
+    } else if([scheme isEqualToString:GPM_WEBVIEW_API_CLOSE]) {
+        return GPMWebViewRequestRouter::CLOSE;
+    } else if([scheme isEqualToString:GPM_WEBVIEW_API_SET_FILE_DOWNLOAD_PATH] ||
+              [scheme isEqualToString:GPM_WEBVIEW_API_SHOW_WEB_BROWSER]) {
+        return GPMWebViewRequestRouter::APP_REQUEST;
+    }
+    return GPMWebViewRequestRouter::INSTANCE_REQUEST;
+}
+
+// Refreshes the snapshot read by getWebViewState. Called from view events and geometry setters, never per query.
+- (void)publishStateWithInstanceId:(NSInteger)instanceId backend:(id<GPMWebViewBackend>)backend {
+    GPMWebViewRequestRouter::Entry entry;
+    if(_router->find(instanceId, entry) == false || entry.backend != backend) {
+        return;
+    }
+    
+    [[GPMWebViewStateSnapshot snapshotWithInstanceId:instanceId] publishState:[backend state]];
+}
+
 - (GPMCommunicatorMessage*)getBoolMessage:(BOOL)result {
     GPMCommunicatorMessage* message = [[GPMCommunicatorMessage alloc] init];
     message.domain = GPM_WEBVIEW_DOMAIN;
@@ -0,0 +1,109 @@
+#ifndef GPMWebViewInstanceTable_h
+#define GPMWebViewInstanceTable_h
+
+#include <cstddef>
+#include <mutex>
+
+namespace gpm {
+
+// Webview instances by id. An instance is open from its show request until its close callback,
+// and holds the backend presenting it and the callback handle of the show.
+// With singleView only one instance can be open at a time, for backends that present one view for the whole app.
+// Entries are copied out under the lock, so backends are called without it and may call back into the table.
+template <typename Backend, long InstanceCount>
+class WebViewInstanceTable {
+public:
+    enum OpenResult {
+        OPENED,
+        INVALID_INSTANCE,
+        ALREADY_OPEN,
+        VIEW_IN_USE
+    };
+
+    struct Entry {
+        Backend backend;
+        long callback;
+
+        Entry() : backend(), callback(0) {
+        }
+    };
+
+    explicit WebViewInstanceTable(bool singleView) : _singleView(singleView), _openCount(0) {
+        for(long index = 0; index < InstanceCount; index++) {
+            _isOpen[index] = false;
+        }
+    }
+
+    static bool isValid(long instanceId) {
+        return instanceId >= 0 && instanceId < InstanceCount;
+    }
+
+    OpenResult open(long instanceId, const Entry& entry) {
+        if(isValid(instanceId) == false) {
+            return INVALID_INSTANCE;
+        }
+
+        std::lock_guard<std::mutex> lock(_mutex);
+        if(_isOpen[instanceId] == true) {
+            return ALREADY_OPEN;
+        }
+        if(_singleView == true && _openCount > 0) {
+            return VIEW_IN_USE;
+        }
+
+        _entries[instanceId] = entry;
+        _isOpen[instanceId] = true;
+        _openCount++;
+        return OPENED;
+    }
+
+    bool find(long instanceId, Entry& entry) const {
+        if(isValid(instanceId) == false) {
+            return false;
+        }
+
+        std::lock_guard<std::mutex> lock(_mutex);
+        if(_isOpen[instanceId] == false) {
+            return false;
+        }
+        entry = _entries[instanceId];
+        return true;
+    }
+
+    // Closes the instance only while backend still holds it, so a late callback of a closed view
+    // cannot close the view the instance opened after it.
+    bool close(long instanceId, const Backend& backend) {
+        if(isValid(instanceId) == false) {
+            return false;
+        }
+
+        std::lock_guard<std::mutex> lock(_mutex);
+        if(_isOpen[instanceId] == false || !(_entries[instanceId].backend == backend)) {
+            return false;
+        }
+
+        _entries[instanceId] = Entry();
+        _isOpen[instanceId] = false;
+        _openCount--;
+        return true;
+    }
+
+    size_t openCount() const {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _openCount;
+    }
+
+private:
+    WebViewInstanceTable(const WebViewInstanceTable&);
+    WebViewInstanceTable& operator=(const WebViewInstanceTable&);
+
+    const bool _singleView;
+    size_t _openCount;
+    bool _isOpen[InstanceCount];
+    Entry _entries[InstanceCount];
+    mutable std::mutex _mutex;
+};
+
+}
+
+#endif /* GPMWebViewInstanceTable_h */
@@ -0,0 +1,97 @@
+#ifndef GPMWebViewRequestRouter_h
+#define GPMWebViewRequestRouter_h
+
+#include "GPMWebViewInstanceTable.h"
+
+namespace gpm {
+
+// Decides where a webview request goes: a show opens its instance, a request to an open instance goes to its backend,
+// and one that needs no instance, such as showWebBrowser, is served by the plugin.
+// A request to an instance that is not open is answered with a request failed callback, except
+// on the default instance used by GpmWebView, which has always dropped them silently, and a close, which has nothing to do.
+template <typename Backend, long InstanceCount>
+class WebViewRequestRouter {
+public:
+    typedef WebViewInstanceTable<Backend, InstanceCount> Table;
+    typedef typename Table::Entry Entry;
+
+    static const long DEFAULT_INSTANCE_ID = 0;
+
+    enum RequestKind {
+        SHOW,
+        CLOSE,
+        INSTANCE_REQUEST,
+        APP_REQUEST
+    };
+
+    enum Route {
+        DROP,
+        OPEN,
+        REFUSE_ALREADY_OPEN,
+        REFUSE_VIEW_IN_USE,
+        SERVE_APP,
+        SERVE_BACKEND,
+        IGNORE,
+        FAIL
+    };
+
+    explicit WebViewRequestRouter(bool singleView) : _table(singleView) {
+    }
+
+    // For a show, entry holds the new backend and the callback of the show, and is opened on OPEN.
+    // For SERVE_BACKEND, entry receives the open instance.
+    Route route(long instanceId, RequestKind kind, Entry& entry) {
+        if(Table::isValid(instanceId) == false) {
+            return DROP;
+        }
+
+        switch(kind) {
+            case SHOW:
+                switch(_table.open(instanceId, entry)) {
+                    case Table::OPENED:
+                        return OPEN;
+                    case Table::ALREADY_OPEN:
+                        return REFUSE_ALREADY_OPEN;
+                    case Table::VIEW_IN_USE:
+                        return REFUSE_VIEW_IN_USE;
+                    default:
+                        return DROP;
+                }
+            case APP_REQUEST:
+                return SERVE_APP;
+            default:
+                break;
+        }
+
+        if(_table.find(instanceId, entry) == true) {
+            return SERVE_BACKEND;
+        }
+        if(kind == CLOSE || instanceId == DEFAULT_INSTANCE_ID) {
+            return IGNORE;
+        }
+        return FAIL;
+    }
+
+    bool find(long instanceId, Entry& entry) const {
+        return _table.find(instanceId, entry);
+    }
+
+    // From the close callback of backend. See WebViewInstanceTable::close.
+    bool close(long instanceId, const Backend& backend) {
+        return _table.close(instanceId, backend);
+    }
+
+    size_t openCount() const {
+        return _table.openCount();
+    }
+
+private:
+    WebViewRequestRouter(const WebViewRequestRouter&);
+    WebViewRequestRouter& operator=(const WebViewRequestRouter&);
+
+    Table _table;
+};
+
+}
+
+#endif /* GPMWebViewRequestRouter_h */
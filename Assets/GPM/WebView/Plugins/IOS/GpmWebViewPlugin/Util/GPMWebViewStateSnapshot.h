@@ -0,0 +1,22 @@
+#import <Foundation/Foundation.h>
+
+// Matches GpmWebViewState on the managed side, field for field.
+typedef struct {
+    int32_t isActive;
+    int32_t canGoBack;
+    int32_t canGoForward;
+    int32_t x;
+    int32_t y;
+    int32_t width;
+    int32_t height;
+} GPMWebViewState;
+
+#define GPM_WEBVIEW_MAX_INSTANCE_COUNT 16
+
+@interface GPMWebViewStateSnapshot : NSObject
+
++ (GPMWebViewStateSnapshot*)snapshotWithInstanceId:(NSInteger)instanceId;
+- (void)publishState:(GPMWebViewState)state;
+- (GPMWebViewState)readState;
+
+@end
@@ -0,0 +1,55 @@
+#import "GPMWebViewStateSnapshot.h"
+#import "GPMWebViewPlugin.h"
+#import "GPMCommunicatorPlugin.h"
+#import "GPMSeqLock.h"
+
+// Readers never block and never call into the WebView, so the state can be read from any thread.
+@implementation GPMWebViewStateSnapshot {
+    gpm::SeqLock<GPMWebViewState> _state;
+}
+
+// One snapshot per instance, created up front so lookups from any thread never touch a mutable table.
++ (GPMWebViewStateSnapshot*)snapshotWithInstanceId:(NSInteger)instanceId {
+    static dispatch_once_t onceToken;
+    static NSArray* snapshotArray = nil;
+    dispatch_once(&onceToken, ^{
+        NSMutableArray* snapshots = [NSMutableArray arrayWithCapacity:GPM_WEBVIEW_MAX_INSTANCE_COUNT];
+        for(NSInteger index = 0; index < GPM_WEBVIEW_MAX_INSTANCE_COUNT; index++) {
+            [snapshots addObject:[[GPMWebViewStateSnapshot alloc] init]];
+        }
+        snapshotArray = [snapshots copy];
+    });
+    
+    if(instanceId < 0 || instanceId >= GPM_WEBVIEW_MAX_INSTANCE_COUNT) {
+        return nil;
+    }
+    return [snapshotArray objectAtIndex:instanceId];
+}
+
+- (void)publishState:(GPMWebViewState)state {
+    _state.store(state);
+}
+
+- (GPMWebViewState)readState {
+    return _state.load();
+}
+@end
+
+#pragma mark - extern C
+extern "C" {
+    void getWebViewState(int instanceId, GPMWebViewState* state)
+    {
+        if(state == NULL) {
+            return;
+        }
+        
+        // Only the snapshot is read. Queued requests are applied by applyPendingWebViewRequests when the caller asks.
+        GPMWebViewStateSnapshot* snapshot = [GPMWebViewStateSnapshot snapshotWithInstanceId:instanceId];
+        *state = (snapshot != nil) ? [snapshot readState] : GPMWebViewState();
+    }
+    
+    void applyPendingWebViewRequests()
+    {
+        [[GPMCommunicatorPlugin sharedGPMCommunicatorPlugin] drainPendingMessagesWithDomain:GPM_WEBVIEW_DOMAIN];
+    }
+}
@@ -0,0 +1,83 @@
+#ifndef GPMWebViewStubView_h
+#define GPMWebViewStubView_h
+
+#include <cstdint>
+
+namespace gpm {
+
+// The view state of GPMWebViewStubBackend: one page, no history, geometry kept in memory.
+// State is GPMWebViewState, or any struct with the same fields.
+template <typename State>
+class WebViewStubView {
+public:
+    struct Geometry {
+        bool hasPosition;
+        int32_t x;
+        int32_t y;
+        bool hasSize;
+        int32_t width;
+        int32_t height;
+
+        Geometry() : hasPosition(false), x(0), y(0), hasSize(false), width(0), height(0) {
+        }
+    };
+
+    WebViewStubView() : _state() {
+    }
+
+    // Returns false while the view is already shown.
+    bool show(const Geometry& geometry) {
+        if(_state.isActive != 0) {
+            return false;
+        }
+
+        _state = State();
+        _state.isActive = 1;
+        if(geometry.hasPosition == true) {
+            _state.x = geometry.x;
+            _state.y = geometry.y;
+        }
+        if(geometry.hasSize == true) {
+            _state.width = geometry.width;
+            _state.height = geometry.height;
+        }
+        return true;
+    }
+
+    // Returns false when the view was not shown.
+    bool close() {
+        if(_state.isActive == 0) {
+            return false;
+        }
+
+        _state = State();
+        return true;
+    }
+
+    void setPosition(int32_t x, int32_t y) {
+        _state.x = x;
+        _state.y = y;
+    }
+
+    void setSize(int32_t width, int32_t height) {
+        _state.width = width;
+        _state.height = height;
+    }
+
+    // Margins place the view, the stub keeps its size.
+    void setMargins(int32_t left, int32_t top) {
+        _state.x = left;
+        _state.y = top;
+    }
+
+    const State& state() const {
+        return _state;
+    }
+
+private:
+    State _state;
+};
+
+}
+
+#endif /* GPMWebViewStubView_h */
@@ -7,6 +7,7 @@
     NSString* _extra;
     NSInteger _callback;
     NSInteger _callbackType;
+    NSInteger _instanceId;
 }
 
 @property (nonatomic, strong) NSString* scheme;
@@ -15,6 +16,7 @@
 @property (nonatomic, strong) NSString* error;
 @property (nonatomic, assign) NSInteger callback;
 @property (nonatomic, assign) NSInteger callbackType;
+@property (nonatomic, assign) NSInteger instanceId;
 
 -(id)initWithJsonString:(NSString*)jsonString;
 -(NSString*)toJsonString;
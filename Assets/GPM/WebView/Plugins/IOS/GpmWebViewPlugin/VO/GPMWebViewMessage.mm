@@ -10,6 +10,7 @@
 @synthesize error = _error;
 @synthesize callback = _callback;
 @synthesize callbackType = _callbackType;
+@synthesize instanceId = _instanceId;
 
 -(id)initWithJsonString:(NSString*)jsonString {
     if(self = [super init]) {        
@@ -21,6 +22,7 @@
         self.error = convertedDic[@"error"];
         self.callback = [convertedDic[@"callback"] intValue];
         self.callbackType = [convertedDic[@"callbackType"] intValue];
+        self.instanceId = [convertedDic[@"instanceId"] intValue];
     }
     return self;
 }
@@ -0,0 +1,16 @@
+﻿namespace Gpm.WebView
+{
+    /// <summary>
+    /// State of the webview read in a single call.
+    /// </summary>
+    public struct GpmWebViewState
+    {
+        public bool isActive;
+        public bool canGoBack;
+        public bool canGoForward;
+        public int x;
+        public int y;
+        public int width;
+        public int height;
+    }
+}
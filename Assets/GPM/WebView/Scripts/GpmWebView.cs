@@ -132,6 +132,41 @@
             return WebViewImplementation.Instance.GetHeight();
         }
 
+        /// <summary>
+        /// Returns IsActive, CanGoBack, CanGoForward and the position and size of the webview in one call.
+        /// On iOS it only reads a snapshot kept up to date by webview events, without waiting for queued requests,
+        /// so a request sent just before may not be reflected yet. Call <see cref="ApplyPendingRequests"/> first when it must be.
+        /// </summary>
+        public static GpmWebViewState GetState()
+        {
+            return WebViewImplementation.Instance.GetState();
+        }
+
+        /// <summary>
+        /// Sends and applies every queued request now, such as SetPosition or GoBack.
+        /// It can block on a large pending request, so call it only before a GetState that must see those requests.
+        /// </summary>
+        public static void ApplyPendingRequests()
+        {
+            WebViewImplementation.Instance.ApplyPendingRequests();
+        }
+
+        /// <summary>
+        /// Creates a webview instance with its own requests, callbacks and state. Release it when done, up to 15 can exist at once.
+        /// Returns null when none is left, and on Android.
+        /// </summary>
+        public static GpmWebViewInstance CreateInstance()
+        {
+            int instanceId;
+            IWebView webview = WebViewImplementation.Instance.CreateWebView(out instanceId);
+            if (webview == null)
+            {
+                return null;
+            }
+
+            return new GpmWebViewInstance(instanceId, webview);
+        }
+
         /// <summary>
         /// Open a Web Browser with the specified URL.
         /// </summary>
@@ -21,6 +21,12 @@
             /// </summary>
             BackButtonClose,
 #endif
+
+            /// <summary>
+            /// A request other than show or close reached a GpmWebViewInstance that is not open. data is the scheme of the request.
+            /// Sent to the callback of the last show of the instance. Requests through GpmWebView are still dropped silently.
+            /// </summary>
+            RequestFailed = 100,
         }
 
         public delegate void GpmWebViewDelegate(CallbackType type, string data, GpmWebViewError error);
@@ -0,0 +1,194 @@
+﻿namespace Gpm.WebView
+{
+    using System.Collections.Generic;
+    using Gpm.WebView.Internal;
+    using UnityEngine;
+
+    /// <summary>
+    /// A webview with its own instance id, created with <see cref="GpmWebView.CreateInstance"/>.
+    /// Requests, callbacks and state are kept apart from GpmWebView and from other instances.
+    /// iOS shows one webview at a time, so a show while another instance is shown gets an Open callback with GPM_WEBVIEW_ERROR_ALREADY_OPEN.
+    /// Other requests to an instance that is not shown, except Close, get a RequestFailed callback.
+    /// </summary>
+    public sealed class GpmWebViewInstance
+    {
+        private readonly IWebView webview;
+        private bool isReleased = false;
+
+        internal GpmWebViewInstance(int instanceId, IWebView webview)
+        {
+            InstanceId = instanceId;
+            this.webview = webview;
+        }
+
+        public int InstanceId { get; private set; }
+
+        public void ShowUrl(
+            string url,
+            GpmWebViewRequest.Configuration configuration,
+            GpmWebViewCallback.GpmWebViewDelegate callback,
+            List<string> schemeList)
+        {
+            if (CheckReleased("ShowUrl") == false)
+            {
+                webview.ShowUrl(url, configuration, callback, schemeList);
+            }
+        }
+
+        public void ShowHtmlFile(
+            string filePath,
+            GpmWebViewRequest.Configuration configuration,
+            GpmWebViewCallback.GpmWebViewDelegate callback,
+            List<string> schemeList)
+        {
+            if (CheckReleased("ShowHtmlFile") == false)
+            {
+                webview.ShowHtmlFile(filePath, configuration, callback, schemeList);
+            }
+        }
+
+        public void ShowHtmlString(
+            string htmlString,
+            GpmWebViewRequest.Configuration configuration,
+            GpmWebViewCallback.GpmWebViewDelegate callback,
+            List<string> schemeList)
+        {
+            if (CheckReleased("ShowHtmlString") == false)
+            {
+                webview.ShowHtmlString(htmlString, configuration, callback, schemeList);
+            }
+        }
+
+        public void ShowSafeBrowsing(
+            string url,
+            GpmWebViewRequest.ConfigurationSafeBrowsing configuration = null,
+            GpmWebViewCallback.GpmWebViewDelegate callback = null)
+        {
+            if (CheckReleased("ShowSafeBrowsing") == false)
+            {
+                webview.ShowSafeBrowsing(url, configuration, callback);
+            }
+        }
+
+        public void ExecuteJavaScript(string script)
+        {
+            if (CheckReleased("ExecuteJavaScript") == false)
+            {
+                webview.ExecuteJavaScript(script);
+            }
+        }
+
+        public void Close()
+        {
+            if (CheckReleased("Close") == false)
+            {
+                webview.Close();
+            }
+        }
+
+        public bool IsActive()
+        {
+            return CheckReleased("IsActive") == false && webview.IsActive();
+        }
+
+        public bool CanGoBack()
+        {
+            return CheckReleased("CanGoBack") == false && webview.CanGoBack;
+        }
+
+        public bool CanGoForward()
+        {
+            return CheckReleased("CanGoForward") == false && webview.CanGoForward;
+        }
+
+        public void GoBack()
+        {
+            if (CheckReleased("GoBack") == false)
+            {
+                webview.GoBack();
+            }
+        }
+
+        public void GoForward()
+        {
+            if (CheckReleased("GoForward") == false)
+            {
+                webview.GoForward();
+            }
+        }
+
+        public void SetPosition(int x, int y)
+        {
+            if (CheckReleased("SetPosition") == false)
+            {
+                webview.SetPosition(x, y);
+            }
+        }
+
+        public void SetSize(int width, int height)
+        {
+            if (CheckReleased("SetSize") == false)
+            {
+                webview.SetSize(width, height);
+            }
+        }
+
+        public void SetMargins(int left, int top, int right, int bottom)
+        {
+            if (CheckReleased("SetMargins") == false)
+            {
+                webview.SetMargins(left, top, right, bottom);
+            }
+        }
+
+        /// <summary>
+        /// Same as <see cref="GpmWebView.GetState"/>, for this instance.
+        /// </summary>
+        public GpmWebViewState GetState()
+        {
+            if (CheckReleased("GetState") == true)
+            {
+                return new GpmWebViewState();
+            }
+
+            return webview.GetState();
+        }
+
+        /// <summary>
+        /// Same as <see cref="GpmWebView.ApplyPendingRequests"/>, for this instance.
+        /// </summary>
+        public void ApplyPendingRequests()
+        {
+            if (CheckReleased("ApplyPendingRequests") == false)
+            {
+                webview.ApplyPendingRequests();
+            }
+        }
+
+        /// <summary>
+        /// Closes the webview and hands the instance id back for a later <see cref="GpmWebView.CreateInstance"/>.
+        /// The instance can not be used afterwards. The callback of a shown webview still gets its Close callback.
+        /// </summary>
+        public void Release()
+        {
+            if (isReleased == true)
+            {
+                return;
+            }
+
+            isReleased = true;
+            webview.Close();
+            WebViewImplementation.Instance.ReleaseWebView(InstanceId);
+        }
+
+        private bool CheckReleased(string methodName)
+        {
+            if (isReleased == true)
+            {
+                Debug.LogWarning(string.Format("The webview instance is released. instanceId:{0}, method:{1}", InstanceId, methodName));
+            }
+
+            return isReleased;
+        }
+    }
+}
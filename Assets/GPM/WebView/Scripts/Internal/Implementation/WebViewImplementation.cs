@@ -1,6 +1,7 @@
 ﻿namespace Gpm.WebView.Internal
 {
     using System.Collections.Generic;
+    using UnityEngine;
 
     public class WebViewImplementation
     {
@@ -11,8 +12,17 @@
             get { return instance; }
         }
 
+        /// <summary>
+        /// Matches GPM_WEBVIEW_MAX_INSTANCE_COUNT of the iOS plugin. Id 0 is the webview of GpmWebView.
+        /// </summary>
+        public const int MAX_INSTANCE_COUNT = 16;
+
         private IWebView webview;
 
+        // Kept per id and reused, since a communicator receiver can not be removed.
+        private readonly IWebView[] instanceWebViews = new IWebView[MAX_INSTANCE_COUNT];
+        private readonly bool[] isInstanceUsed = new bool[MAX_INSTANCE_COUNT];
+
         private WebViewImplementation()
         {
 #if UNITY_ANDROID && !UNITY_EDITOR
@@ -24,6 +34,58 @@
 #endif
         }
 
+        /// <summary>
+        /// Returns null when every id is in use, and on Android, whose plugin has a single webview.
+        /// </summary>
+        public IWebView CreateWebView(out int instanceId)
+        {
+            instanceId = -1;
+#if UNITY_ANDROID && !UNITY_EDITOR
+            Debug.LogWarning("Webview instances are not supported on Android");
+            return null;
+#else
+            for (int id = NativeWebView.DEFAULT_INSTANCE_ID + 1; id < MAX_INSTANCE_COUNT; id++)
+            {
+                if (isInstanceUsed[id] == true)
+                {
+                    continue;
+                }
+
+                if (instanceWebViews[id] == null)
+                {
+#if UNITY_IPHONE && !UNITY_EDITOR
+                    instanceWebViews[id] = new IOSWebView(id);
+#else
+                    instanceWebViews[id] = new DefaultWebView();
+#endif
+                }
+
+                isInstanceUsed[id] = true;
+                instanceId = id;
+                return instanceWebViews[id];
+            }
+
+            Debug.LogWarning(string.Format("Every webview instance is in use. max:{0}", MAX_INSTANCE_COUNT - 1));
+            return null;
+#endif
+        }
+
+        public void ReleaseWebView(int instanceId)
+        {
+            if (instanceId <= NativeWebView.DEFAULT_INSTANCE_ID || instanceId >= MAX_INSTANCE_COUNT || isInstanceUsed[instanceId] == false)
+            {
+                return;
+            }
+
+            NativeWebView nativeWebView = instanceWebViews[instanceId] as NativeWebView;
+            if (nativeWebView != null)
+            {
+                nativeWebView.Release();
+            }
+
+            isInstanceUsed[instanceId] = false;
+        }
+
         public void ShowUrl(
             string url,
             GpmWebViewRequest.Configuration configuration,
@@ -134,6 +196,16 @@
             return webview.GetHeight();
         }
 
+        public GpmWebViewState GetState()
+        {
+            return webview.GetState();
+        }
+
+        public void ApplyPendingRequests()
+        {
+            webview.ApplyPendingRequests();
+        }
+
         public void ShowWebBrowser(string url)
         {
             webview.ShowWebBrowser(url);
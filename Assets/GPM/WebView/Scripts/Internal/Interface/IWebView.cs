@@ -45,6 +45,8 @@
         int GetY();
         int GetWidth();
         int GetHeight();
+        GpmWebViewState GetState();
+        void ApplyPendingRequests();
 
         void ShowWebBrowser(string url);
     }
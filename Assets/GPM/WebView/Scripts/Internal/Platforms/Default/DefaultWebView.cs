@@ -113,6 +113,17 @@
             return 0;
         }
 
+        public GpmWebViewState GetState()
+        {
+            Debug.LogWarning("Not supported method in the editor");
+            return new GpmWebViewState();
+        }
+
+        public void ApplyPendingRequests()
+        {
+            Debug.LogWarning("Not supported method in the editor");
+        }
+
         public void ShowWebBrowser(string url)
         {
             Debug.LogWarning("Not supported method in the editor");
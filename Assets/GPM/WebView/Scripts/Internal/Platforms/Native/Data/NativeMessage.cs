@@ -8,5 +8,6 @@
         public string extra;
         public int callback;
         public int callbackType;
+        public int instanceId;
     }
 }
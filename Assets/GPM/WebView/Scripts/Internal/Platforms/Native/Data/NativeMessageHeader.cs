@@ -0,0 +1,11 @@
+﻿namespace Gpm.WebView.Internal
+{
+    /// <summary>
+    /// Sent as extra of an async message, so native can queue the message without parsing its data.
+    /// </summary>
+    public class NativeMessageHeader
+    {
+        public string scheme;
+        public int instanceId;
+    }
+}
@@ -1,13 +1,79 @@
 ﻿namespace Gpm.WebView.Internal
 {
+    using System.Runtime.InteropServices;
+    using Gpm.Common.ThirdParty.LitJson;
+
     public class IOSWebView : NativeWebView
     {
         private const string IOS_CLASS_NAME = "GPMWebViewPlugin";
 
+        [StructLayout(LayoutKind.Sequential)]
+        private struct NativeState
+        {
+            public int isActive;
+            public int canGoBack;
+            public int canGoForward;
+            public int x;
+            public int y;
+            public int width;
+            public int height;
+        }
+
+        [DllImport("__Internal")]
+        private static extern void getWebViewState(int instanceId, out NativeState state);
+
+        [DllImport("__Internal")]
+        private static extern void applyPendingWebViewRequests();
+
+        public IOSWebView()
+        {
+        }
+
+        public IOSWebView(int instanceId) : base(instanceId)
+        {
+        }
+
         override protected void Initialize()
         {
             CLASS_NAME = IOS_CLASS_NAME;
             base.Initialize();
         }
+
+        override protected string GetCallbackTopic()
+        {
+            return string.Format("{0}/{1}", CallbackScheme.WEBVIEW_CALLBACK, instanceId);
+        }
+
+        override protected string MakeExtra(NativeMessage nativeMessage)
+        {
+            return JsonMapper.ToJson(new NativeMessageHeader
+            {
+                scheme = nativeMessage.scheme,
+                instanceId = nativeMessage.instanceId
+            });
+        }
+
+        override public GpmWebViewState GetState()
+        {
+            NativeState state;
+            getWebViewState(instanceId, out state);
+
+            return new GpmWebViewState()
+            {
+                isActive = state.isActive != 0,
+                canGoBack = state.canGoBack != 0,
+                canGoForward = state.canGoForward != 0,
+                x = state.x,
+                y = state.y,
+                width = state.width,
+                height = state.height
+            };
+        }
+
+        override public void ApplyPendingRequests()
+        {
+            base.ApplyPendingRequests();
+            applyPendingWebViewRequests();
+        }
     }
 }
@@ -43,12 +43,22 @@
             public const string WEBVIEW_CALLBACK = "gpmwebview://webViewCallback";
         }
 
+        public const int DEFAULT_INSTANCE_ID = 0;
+
         private const string DOMAIN = "GPM_WEBVIEW";
         private const string DEFAULT_NAVIGATION_BAR_COLOR = "#4B96E6";
         private const string DEFAULT_NAVIGATION_TEXT_COLOR = "#FFFFFF";
 
         protected string CLASS_NAME = string.Empty;
 
+        protected readonly int instanceId;
+
+        /// <summary>
+        /// Callback of the last show, which also receives RequestFailed for the requests of this instance.
+        /// </summary>
+        private GpmWebViewCallback.GpmWebViewDelegate showCallback;
+        private bool isReleased = false;
+
         private const int AUTO_ROTATION_MIN_COUNT = 2;
         private bool isAutorotateToPortrait = false;
         private bool isAutorotateToPortraitUpsideDown = false;
@@ -65,7 +75,7 @@
                     scheme = ApiScheme.CAN_GO_BACK
                 };
 
-                var resultMessage = CallSync(JsonMapper.ToJson(message), string.Empty);
+                var resultMessage = CallSync(message);
 
                 return Convert.ToBoolean(resultMessage.data);
             }
@@ -80,14 +90,19 @@
                     scheme = ApiScheme.CAN_GO_FORWARD
                 };
 
-                var resultMessage = CallSync(JsonMapper.ToJson(message), string.Empty);
+                var resultMessage = CallSync(message);
 
                 return Convert.ToBoolean(resultMessage.data);
             }
         }
 
-        public NativeWebView()
+        public NativeWebView() : this(DEFAULT_INSTANCE_ID)
+        {
+        }
+
+        public NativeWebView(int instanceId)
         {
+            this.instanceId = instanceId;
             Initialize();
         }
 
@@ -99,7 +114,24 @@
             };
 
             GpmCommunicator.InitializeClass(configuration);
-            GpmCommunicator.AddReceiver(DOMAIN, OnAsyncEvent);
+            GpmCommunicator.AddReceiver(DOMAIN, GetCallbackTopic(), OnAsyncEvent);
+        }
+
+        /// <summary>
+        /// Topic of the callbacks sent to this instance. Null receives every callback of the domain.
+        /// </summary>
+        virtual protected string GetCallbackTopic()
+        {
+            return null;
+        }
+
+        /// <summary>
+        /// Called when the instance id is handed back. Requests that fail afterwards are no longer reported to the last show callback.
+        /// </summary>
+        public void Release()
+        {
+            showCallback = null;
+            isReleased = true;
         }
 
         public void ShowUrl(
@@ -113,11 +145,13 @@
                 scheme = ApiScheme.SHOW_URL,
                 callback = NativeCallbackHandler.RegisterCallback(callback)
             };
+            showCallback = callback;
+            isReleased = false;
 
             NativeRequest.ShowWebView showWebView = MakeShowWebView(url, configuration, schemeList);
 
             nativeMessage.data = JsonMapper.ToJson(showWebView);
-            CallAsync(JsonMapper.ToJson(nativeMessage), null);
+            CallAsync(nativeMessage);
         }
 
         public void ShowHtmlFile(
@@ -131,12 +165,14 @@
                 scheme = ApiScheme.SHOW_HTML_FILE,
                 callback = NativeCallbackHandler.RegisterCallback(callback)
             };
+            showCallback = callback;
+            isReleased = false;
 
             NativeRequest.ShowWebView showWebView = MakeShowWebView(filePath, configuration, schemeList);
 
             nativeMessage.data = JsonMapper.ToJson(showWebView);
 
-            CallAsync(JsonMapper.ToJson(nativeMessage), null);
+            CallAsync(nativeMessage);
         }
 
         public void ShowHtmlString(
@@ -150,12 +186,14 @@
                 scheme = ApiScheme.SHOW_HTML_STRING,
                 callback = NativeCallbackHandler.RegisterCallback(callback)
             };
+            showCallback = callback;
+            isReleased = false;
 
             NativeRequest.ShowWebView showWebView = MakeShowWebView(htmlString, configuration, schemeList);
 
             nativeMessage.data = JsonMapper.ToJson(showWebView);
 
-            CallAsync(JsonMapper.ToJson(nativeMessage), null);
+            CallAsync(nativeMessage);
         }
 
         public void ShowSafeBrowsing(
@@ -168,6 +206,8 @@
                 scheme = ApiScheme.SHOW_SAFE_BROWSING,
                 callback = NativeCallbackHandler.RegisterCallback(callback)
             };
+            showCallback = callback;
+            isReleased = false;
 
             NativeRequest.ShowSafeBrowsing showSafeBrowsing = new NativeRequest.ShowSafeBrowsing
             {
@@ -181,7 +221,7 @@
 
             nativeMessage.data = JsonMapper.ToJson(showSafeBrowsing);
 
-            CallAsync(JsonMapper.ToJson(nativeMessage), null);
+            CallAsync(nativeMessage);
         }
 
         public void Close()
@@ -191,9 +231,7 @@
                 scheme = ApiScheme.CLOSE
             };
 
-            string jsonData = JsonMapper.ToJson(nativeMessage);
-
-            CallAsync(jsonData, null);
+            CallAsync(nativeMessage);
         }
 
         public bool IsActive()
@@ -203,7 +241,7 @@
                 scheme = ApiScheme.IS_ACTIVE
             };
 
-            var resultMessage = CallSync(JsonMapper.ToJson(message), string.Empty);
+            var resultMessage = CallSync(message);
 
             return Convert.ToBoolean(resultMessage.data);
         }
@@ -220,9 +258,7 @@
                 script = script
             });
 
-            string jsonData = JsonMapper.ToJson(nativeMessage);
-
-            CallAsync(jsonData, null);
+            CallAsync(nativeMessage);
         }
 
         public void SetFileDownloadPath(string path)
@@ -232,9 +268,7 @@
                 scheme = ApiScheme.SET_FILE_DOWNLOAD_PATH
             };
 
-            string jsonData = JsonMapper.ToJson(nativeMessage);
-
-            CallAsync(jsonData, null);
+            CallAsync(nativeMessage);
         }
 
         private NativeRequest.ShowWebView MakeShowWebView(
@@ -299,25 +333,37 @@
             return showWebView;
         }
 
-        private void CallAsync(string data, string extra)
+        private void CallAsync(NativeMessage nativeMessage)
         {
+            nativeMessage.instanceId = instanceId;
+
             GpmCommunicatorVO.Message message = new GpmCommunicatorVO.Message()
             {
                 domain = DOMAIN,
-                data = data,
-                extra = extra
+                data = JsonMapper.ToJson(nativeMessage),
+                extra = MakeExtra(nativeMessage)
             };
 
             GpmCommunicator.CallAsync(message);
         }
 
-        private GpmCommunicatorVO.Message CallSync(string data, string extra)
+        /// <summary>
+        /// Extra sent with an async message. The platform plugin can read it without parsing data.
+        /// </summary>
+        virtual protected string MakeExtra(NativeMessage nativeMessage)
         {
+            return null;
+        }
+
+        private GpmCommunicatorVO.Message CallSync(NativeMessage nativeMessage)
+        {
+            nativeMessage.instanceId = instanceId;
+
             GpmCommunicatorVO.Message message = new GpmCommunicatorVO.Message()
             {
                 domain = DOMAIN,
-                data = data,
-                extra = extra
+                data = JsonMapper.ToJson(nativeMessage),
+                extra = string.Empty
             };
 
             return GpmCommunicator.CallSync(message);
@@ -341,7 +387,18 @@
 
         private void OnWebViewCallback(NativeMessage nativeMessage)
         {
-            var callback = NativeCallbackHandler.GetCallback<GpmWebViewCallback.GpmWebViewDelegate>(nativeMessage.callback);
+            GpmWebViewCallback.CallbackType callbackType = (GpmWebViewCallback.CallbackType)nativeMessage.callbackType;
+            GpmWebViewCallback.GpmWebViewDelegate callback;
+
+            // A failed request carries no callback handle. It goes to the callback of the last show of the instance.
+            if (callbackType == GpmWebViewCallback.CallbackType.RequestFailed)
+            {
+                callback = showCallback;
+            }
+            else
+            {
+                callback = NativeCallbackHandler.GetCallback<GpmWebViewCallback.GpmWebViewDelegate>(nativeMessage.callback);
+            }
 
             if (callback != null)
             {
@@ -352,14 +409,22 @@
                     error = JsonMapper.ToObject<GpmWebViewError>(nativeMessage.error);
                 }
 
-                GpmWebViewCallback.CallbackType callbackType = (GpmWebViewCallback.CallbackType)nativeMessage.callbackType;
                 if (callbackType == GpmWebViewCallback.CallbackType.Close)
                 {
                     NativeCallbackHandler.UnregisterCallback(nativeMessage.callback);
                     RestoreOrientation();
                 }
+                else if (callbackType == GpmWebViewCallback.CallbackType.Open && error != null)
+                {
+                    // The show was refused, no close callback follows.
+                    NativeCallbackHandler.UnregisterCallback(nativeMessage.callback);
+                }
                 callback(callbackType, nativeMessage.data, error);
             }
+            else if (callbackType == GpmWebViewCallback.CallbackType.RequestFailed && isReleased == false)
+            {
+                Debug.LogWarning(string.Format("Webview request failed. instanceId:{0}, scheme:{1}", instanceId, nativeMessage.data));
+            }
         }
 
         public void GoBack()
@@ -369,9 +434,7 @@
                 scheme = ApiScheme.GO_BACK
             };
 
-            string jsonData = JsonMapper.ToJson(nativeMessage);
-
-            CallAsync(jsonData, null);
+            CallAsync(nativeMessage);
         }
 
         public void GoForward()
@@ -381,9 +444,7 @@
                 scheme = ApiScheme.GO_FORWARD
             };
 
-            string jsonData = JsonMapper.ToJson(nativeMessage);
-
-            CallAsync(jsonData, null);
+            CallAsync(nativeMessage);
         }
 
         public void SetPosition(int x, int y)
@@ -399,9 +460,7 @@
                 y = y
             });
 
-            string jsonData = JsonMapper.ToJson(nativeMessage);
-
-            CallAsync(jsonData, null);
+            CallAsync(nativeMessage);
         }
 
         public void SetSize(int width, int height)
@@ -417,9 +476,7 @@
                 height = height
             });
 
-            string jsonData = JsonMapper.ToJson(nativeMessage);
-
-            CallAsync(jsonData, null);
+            CallAsync(nativeMessage);
         }
 
         public void SetMargins(int left, int top, int right, int bottom)
@@ -437,9 +494,7 @@
                 bottom = bottom
             });
 
-            string jsonData = JsonMapper.ToJson(nativeMessage);
-
-            CallAsync(jsonData, null);
+            CallAsync(nativeMessage);
         }
 
         public int GetX()
@@ -449,7 +504,7 @@
                 scheme = ApiScheme.GET_X
             };
 
-            var resultMessage = CallSync(JsonMapper.ToJson(message), string.Empty);
+            var resultMessage = CallSync(message);
 
             return Convert.ToInt32(resultMessage.data);
         }
@@ -461,7 +516,7 @@
                 scheme = ApiScheme.GET_Y
             };
 
-            var resultMessage = CallSync(JsonMapper.ToJson(message), string.Empty);
+            var resultMessage = CallSync(message);
 
             return Convert.ToInt32(resultMessage.data);
         }
@@ -473,7 +528,7 @@
                 scheme = ApiScheme.GET_WIDTH
             };
 
-            var resultMessage = CallSync(JsonMapper.ToJson(message), string.Empty);
+            var resultMessage = CallSync(message);
 
             return Convert.ToInt32(resultMessage.data);
         }
@@ -485,11 +540,30 @@
                 scheme = ApiScheme.GET_HEIGHT
             };
 
-            var resultMessage = CallSync(JsonMapper.ToJson(message), string.Empty);
+            var resultMessage = CallSync(message);
 
             return Convert.ToInt32(resultMessage.data);
         }
 
+        virtual public GpmWebViewState GetState()
+        {
+            return new GpmWebViewState()
+            {
+                isActive = IsActive(),
+                canGoBack = CanGoBack,
+                canGoForward = CanGoForward,
+                x = GetX(),
+                y = GetY(),
+                width = GetWidth(),
+                height = GetHeight()
+            };
+        }
+
+        virtual public void ApplyPendingRequests()
+        {
+            GpmCommunicator.FlushPendingMessages();
+        }
+
         private void CheckAutoRotation()
         {
             isAutorotateToPortrait = Screen.autorotateToPortrait;
@@ -575,7 +649,7 @@
 
             nativeMessage.data = JsonMapper.ToJson(showWebBrowser);
 
-            CallAsync(JsonMapper.ToJson(nativeMessage), null);
+            CallAsync(nativeMessage);
         }
     }
 }
@@ -0,0 +1,236 @@
+#include "GPMCompressFrame.h"
+
+#include <gtest/gtest.h>
+#include <zlib.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+// Same values as GPMMessageCompressor.h.
+const size_t DEFAULT_THRESHOLD = 16 * 1024;
+
+const char BASE64_CHARACTERS[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+std::string encodeBase64(const std::vector<uint8_t>& bytes) {
+    std::string encoded;
+    encoded.reserve(gpm::base64Length(bytes.size()));
+    size_t index = 0;
+    for(; index + 2 < bytes.size(); index += 3) {
+        uint32_t value = (bytes[index] << 16) | (bytes[index + 1] << 8) | bytes[index + 2];
+        encoded.push_back(BASE64_CHARACTERS[(value >> 18) & 63]);
+        encoded.push_back(BASE64_CHARACTERS[(value >> 12) & 63]);
+        encoded.push_back(BASE64_CHARACTERS[(value >> 6) & 63]);
+        encoded.push_back(BASE64_CHARACTERS[value & 63]);
+    }
+    if(index < bytes.size()) {
+        uint32_t value = bytes[index] << 16;
+        if(index + 1 < bytes.size()) {
+            value |= bytes[index + 1] << 8;
+        }
+        encoded.push_back(BASE64_CHARACTERS[(value >> 18) & 63]);
+        encoded.push_back(BASE64_CHARACTERS[(value >> 12) & 63]);
+        encoded.push_back(index + 1 < bytes.size() ? BASE64_CHARACTERS[(value >> 6) & 63] : '=');
+        encoded.push_back('=');
+    }
+    return encoded;
+}
+
+std::vector<uint8_t> decodeBase64(const std::string& encoded) {
+    int8_t table[256];
+    std::memset(table, -1, sizeof(table));
+    for(int index = 0; index < 64; index++) {
+        table[(uint8_t)BASE64_CHARACTERS[index]] = (int8_t)index;
+    }
+
+    std::vector<uint8_t> bytes;
+    bytes.reserve(encoded.size() / 4 * 3);
+    uint32_t value = 0;
+    int bits = 0;
+    for(size_t index = 0; index < encoded.size() && encoded[index] != '='; index++) {
+        value = (value << 6) | (uint32_t)table[(uint8_t)encoded[index]];
+        bits += 6;
+        if(bits >= 8) {
+            bits -= 8;
+            bytes.push_back((uint8_t)(value >> bits));
+        }
+    }
+    return bytes;
+}
+
+// Raw deflate into a buffer of capacity bytes, as compression_encode_buffer with COMPRESSION_ZLIB.
+// Returns 0 when the output does not fit.
+size_t deflateRaw(const std::string& source, std::vector<uint8_t>& compressed, size_t capacity) {
+    compressed.resize(capacity);
+    z_stream stream;
+    std::memset(&stream, 0, sizeof(stream));
+    if(deflateInit2(&stream, Z_BEST_SPEED, Z_DEFLATED, -15, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+        return 0;
+    }
+    stream.next_in = (Bytef*)source.data();
+    stream.avail_in = (uInt)source.size();
+    stream.next_out = compressed.data();
+    stream.avail_out = (uInt)capacity;
+    int status = deflate(&stream, Z_FINISH);
+    size_t length = (status == Z_STREAM_END) ? (size_t)stream.total_out : 0;
+    deflateEnd(&stream);
+    compressed.resize(length);
+    return length;
+}
+
+bool inflateRaw(const std::vector<uint8_t>& compressed, std::string& decoded, size_t decodedLength) {
+    decoded.resize(decodedLength);
+    z_stream stream;
+    std::memset(&stream, 0, sizeof(stream));
+    if(inflateInit2(&stream, -15) != Z_OK) {
+        return false;
+    }
+    stream.next_in = (Bytef*)compressed.data();
+    stream.avail_in = (uInt)compressed.size();
+    stream.next_out = (Bytef*)&decoded[0];
+    stream.avail_out = (uInt)decodedLength;
+    int status = inflate(&stream, Z_FINISH);
+    inflateEnd(&stream);
+    return status == Z_STREAM_END && stream.avail_out == 0;
+}
+
+// The sender's decision in GPMMessageCompressor compressString:threshold:. Returns the data as sent.
+std::string encodeMessage(const std::string& source, size_t threshold) {
+    if(source.size() < threshold) {
+        return source;
+    }
+    size_t capacity = gpm::maxCompressedLength(source.size());
+    if(capacity == 0) {
+        return source;
+    }
+    std::vector<uint8_t> compressed;
+    size_t compressedLength = deflateRaw(source, compressed, capacity);
+    if(gpm::isCompressedFrameSmaller(source.size(), compressedLength) == false) {
+        return source;
+    }
+    return std::string(gpm::COMPRESS_HEADER) + std::to_string(source.size()) + gpm::COMPRESS_LENGTH_DELIMITER + encodeBase64(compressed);
+}
+
+// The receiver's side in GPMMessageCompressor decompressString:. Escaped data is not produced here.
+bool decodeMessage(const std::string& sent, std::string& decoded) {
+    if(sent.compare(0, gpm::COMPRESS_HEADER_LENGTH, gpm::COMPRESS_HEADER) != 0) {
+        decoded = sent;
+        return true;
+    }
+    size_t delimiter = sent.find(gpm::COMPRESS_LENGTH_DELIMITER, gpm::COMPRESS_HEADER_LENGTH);
+    if(delimiter == std::string::npos) {
+        return false;
+    }
+    size_t decodedLength = std::stoul(sent.substr(gpm::COMPRESS_HEADER_LENGTH, delimiter - gpm::COMPRESS_HEADER_LENGTH));
+    return inflateRaw(decodeBase64(sent.substr(delimiter + 1)), decoded, decodedLength);
+}
+
+// JSON records like the ones plugins exchange, compressible but not trivially.
+std::string makePayload(size_t length) {
+    std::mt19937 random(7);
+    std::string payload = "[";
+    while(payload.size() < length) {
+        payload += "{\"id\":" + std::to_string(random() % 100000) + ",\"name\":\"item_" + std::to_string(random() % 1000) +
+                   "\",\"price\":" + std::to_string(random() % 10000) + ",\"owned\":" + (random() % 2 == 0 ? "true" : "false") + "},";
+    }
+    payload.resize(length);
+    return payload;
+}
+
+std::string makeNoise(size_t length) {
+    std::mt19937 random(11);
+    std::string noise(length, ' ');
+    for(size_t index = 0; index < length; index++) {
+        noise[index] = (char)('!' + random() % 90);
+    }
+    return noise;
+}
+
+}
+
+TEST(GPMCompressFrameTest, FrameLengthCountsBase64) {
+    EXPECT_EQ(0u, gpm::base64Length(0));
+    EXPECT_EQ(4u, gpm::base64Length(1));
+    EXPECT_EQ(4u, gpm::base64Length(3));
+    EXPECT_EQ(8u, gpm::base64Length(4));
+    EXPECT_EQ(gpm::COMPRESS_HEADER_LENGTH + 4 + 1 + 8, gpm::compressedFrameLength(1000, 6));
+}
+
+TEST(GPMCompressFrameTest, CapacityIsLargestOutputThatPays) {
+    const size_t sourceLengths[] = { 20, 100, 1024, 16 * 1024, 999999, 5 * 1024 * 1024 };
+    for(size_t index = 0; index < sizeof(sourceLengths) / sizeof(sourceLengths[0]); index++) {
+        size_t sourceLength = sourceLengths[index];
+        size_t capacity = gpm::maxCompressedLength(sourceLength);
+        if(capacity == 0) {
+            EXPECT_FALSE(gpm::isCompressedFrameSmaller(sourceLength, 1));
+            continue;
+        }
+        EXPECT_TRUE(gpm::isCompressedFrameSmaller(sourceLength, capacity)) << sourceLength;
+        EXPECT_FALSE(gpm::isCompressedFrameSmaller(sourceLength, capacity + 1)) << sourceLength;
+    }
+}
+
+TEST(GPMCompressFrameTest, DeflateThatDoesNotPayForBase64IsSentAsIs) {
+    std::string noise = makeNoise(64 * 1024);
+    std::vector<uint8_t> compressed;
+
+    // Shrinks under raw deflate, but not by enough to pay for the base64 expansion.
+    size_t compressedLength = deflateRaw(noise, compressed, noise.size());
+    ASSERT_GT(compressedLength, 0u);
+    EXPECT_LT(compressedLength, noise.size());
+    EXPECT_GE(gpm::compressedFrameLength(noise.size(), compressedLength), noise.size());
+
+    EXPECT_EQ(noise, encodeMessage(noise, DEFAULT_THRESHOLD));
+}
+
+TEST(GPMCompressFrameTest, RoundTripsAboveThreshold) {
+    std::string payload = makePayload(100 * 1024);
+    std::string sent = encodeMessage(payload, DEFAULT_THRESHOLD);
+    ASSERT_NE(payload, sent);
+    EXPECT_LT(sent.size(), payload.size());
+
+    std::string decoded;
+    ASSERT_TRUE(decodeMessage(sent, decoded));
+    EXPECT_EQ(payload, decoded);
+}
+
+// Encode and decode of one message at the default threshold, against sending it as is.
+// Sending as is is modelled as the single copy each side makes; marshalling the frame costs the same per byte either way.
+TEST(GPMCompressFrameTest, BenchmarkCompressedAgainstUncompressed) {
+    const size_t payloadLengths[] = { 1024, 16 * 1024, 64 * 1024, 256 * 1024, 1024 * 1024, 5 * 1024 * 1024 };
+
+    for(size_t index = 0; index < sizeof(payloadLengths) / sizeof(payloadLengths[0]); index++) {
+        size_t payloadLength = payloadLengths[index];
+        std::string payload = makePayload(payloadLength);
+        int iterationCount = (int)std::max((size_t)3, (size_t)(16 * 1024 * 1024) / payloadLength);
+
+        std::string sent;
+        std::string decoded;
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        for(int iteration = 0; iteration < iterationCount; iteration++) {
+            sent = encodeMessage(payload, DEFAULT_THRESHOLD);
+            ASSERT_TRUE(decodeMessage(sent, decoded));
+        }
+        std::chrono::nanoseconds compressedElapsed = std::chrono::steady_clock::now() - start;
+        ASSERT_EQ(payload, decoded);
+
+        start = std::chrono::steady_clock::now();
+        for(int iteration = 0; iteration < iterationCount; iteration++) {
+            std::string copied(payload);
+            decoded.assign(copied);
+        }
+        std::chrono::nanoseconds uncompressedElapsed = std::chrono::steady_clock::now() - start;
+
+        std::printf("%7zu bytes : %s, sent %7zu bytes, %9.1f us; as is %9.1f us\n",
+                    payloadLength, sent == payload ? "as is     " : "compressed", sent.size(),
+                    (double)compressedElapsed.count() / iterationCount / 1000.0,
+                    (double)uncompressedElapsed.count() / iterationCount / 1000.0);
+    }
+}
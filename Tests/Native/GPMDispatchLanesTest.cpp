@@ -0,0 +1,192 @@
+#include "GPMDispatchLanes.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace {
+
+typedef gpm::DispatchLanes<int> Lanes;
+
+const char* const DOMAIN = "GPM_WEBVIEW";
+
+void pushBulk(Lanes& lanes, int value, const std::string& session = DOMAIN) {
+    lanes.push(value, DOMAIN, session, gpm::DispatchPriorityBulk, false);
+}
+
+void pushControl(Lanes& lanes, int value, const std::string& session = DOMAIN, bool endsSession = false) {
+    lanes.push(value, DOMAIN, session, gpm::DispatchPriorityControl, endsSession);
+}
+
+std::vector<int> drain(Lanes& lanes) {
+    std::vector<int> values;
+    int value = 0;
+    while(lanes.pop(value) == true) {
+        values.push_back(value);
+    }
+    return values;
+}
+
+}
+
+TEST(GPMDispatchLanesTest, KeepsArrivalOrderWithinBulkLane) {
+    Lanes lanes;
+    for(int value = 0; value < 100; value++) {
+        pushBulk(lanes, value);
+    }
+
+    std::vector<int> values = drain(lanes);
+    ASSERT_EQ(100u, values.size());
+    for(int value = 0; value < 100; value++) {
+        EXPECT_EQ(value, values[value]);
+    }
+}
+
+TEST(GPMDispatchLanesTest, KeepsArrivalOrderWithinControlLane) {
+    Lanes lanes;
+    for(int value = 0; value < 100; value++) {
+        pushControl(lanes, value);
+    }
+
+    std::vector<int> values = drain(lanes);
+    ASSERT_EQ(100u, values.size());
+    for(int value = 0; value < 100; value++) {
+        EXPECT_EQ(value, values[value]);
+    }
+}
+
+TEST(GPMDispatchLanesTest, ServesControlBeforeQueuedBulk) {
+    Lanes lanes;
+    pushBulk(lanes, 1);
+    pushBulk(lanes, 2);
+    pushControl(lanes, 100);
+
+    std::vector<int> values = drain(lanes);
+    ASSERT_EQ(3u, values.size());
+    EXPECT_EQ(100, values[0]);
+    EXPECT_EQ(1, values[1]);
+    EXPECT_EQ(2, values[2]);
+}
+
+TEST(GPMDispatchLanesTest, BoundsBulkStarvationUnderControlBurst) {
+    const size_t burstLimit = 8;
+    Lanes lanes(burstLimit);
+    pushBulk(lanes, -1);
+    for(int value = 0; value < 100; value++) {
+        pushControl(lanes, value);
+    }
+
+    std::vector<int> values = drain(lanes);
+    ASSERT_EQ(101u, values.size());
+    EXPECT_EQ(-1, values[burstLimit]);
+}
+
+TEST(GPMDispatchLanesTest, EndingSessionDropsItsPendingBulkOnly) {
+    Lanes lanes;
+    pushBulk(lanes, 1, "GPM_WEBVIEW/1");
+    pushBulk(lanes, 2, "GPM_WEBVIEW/2");
+    pushBulk(lanes, 3, "GPM_WEBVIEW/1");
+    pushControl(lanes, 4, "GPM_WEBVIEW/1", true);
+    pushBulk(lanes, 5, "GPM_WEBVIEW/1");
+
+    std::vector<int> values = drain(lanes);
+    ASSERT_EQ(3u, values.size());
+    EXPECT_EQ(4, values[0]);
+    EXPECT_EQ(2, values[1]);
+    EXPECT_EQ(5, values[2]);
+    EXPECT_EQ(2u, lanes.droppedCount());
+}
+
+TEST(GPMDispatchLanesTest, CancelSessionKeepsControlMessages) {
+    Lanes lanes;
+    pushBulk(lanes, 1);
+    pushControl(lanes, 2);
+    lanes.cancelSession(DOMAIN);
+    pushBulk(lanes, 3);
+
+    std::vector<int> values = drain(lanes);
+    ASSERT_EQ(2u, values.size());
+    EXPECT_EQ(2, values[0]);
+    EXPECT_EQ(3, values[1]);
+}
+
+TEST(GPMDispatchLanesTest, DrainsOneDomainInOrderBeforeSyncRequest) {
+    Lanes lanes;
+    lanes.push(1, "GPM_WEBVIEW", "GPM_WEBVIEW", gpm::DispatchPriorityBulk, false);
+    lanes.push(2, "OTHER", "OTHER", gpm::DispatchPriorityBulk, false);
+    lanes.push(3, "GPM_WEBVIEW", "GPM_WEBVIEW", gpm::DispatchPriorityBulk, false);
+    lanes.push(4, "OTHER", "OTHER", gpm::DispatchPriorityControl, false);
+    lanes.push(5, "GPM_WEBVIEW", "GPM_WEBVIEW", gpm::DispatchPriorityControl, false);
+
+    std::vector<int> values;
+    int value = 0;
+    while(lanes.pop(value, "GPM_WEBVIEW") == true) {
+        values.push_back(value);
+    }
+    ASSERT_EQ(3u, values.size());
+    EXPECT_EQ(5, values[0]);
+    EXPECT_EQ(1, values[1]);
+    EXPECT_EQ(3, values[2]);
+
+    values = drain(lanes);
+    ASSERT_EQ(2u, values.size());
+    EXPECT_EQ(4, values[0]);
+    EXPECT_EQ(2, values[1]);
+}
+
+TEST(GPMDispatchLanesTest, ControlLatencyUnderSaturatedBulkLane) {
+    const int bulkCount = 100000;
+    const int controlCount = 1000;
+    Lanes lanes;
+    for(int value = 0; value < bulkCount; value++) {
+        pushBulk(lanes, value);
+    }
+
+    // Each control message arrives behind a saturated bulk lane while the lane is being drained.
+    size_t worstPops = 0;
+    std::chrono::nanoseconds worstLatency(0);
+    int value = 0;
+    for(int control = 0; control < controlCount; control++) {
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        pushControl(lanes, -1);
+
+        size_t pops = 0;
+        do {
+            ASSERT_TRUE(lanes.pop(value));
+            pops++;
+        } while(value != -1);
+
+        std::chrono::nanoseconds latency = std::chrono::steady_clock::now() - start;
+        worstPops = std::max(worstPops, pops);
+        worstLatency = std::max(worstLatency, latency);
+
+        // Keeps the bulk lane saturated.
+        ASSERT_TRUE(lanes.pop(value));
+        pushBulk(lanes, value);
+    }
+
+    EXPECT_EQ(1u, worstPops);
+    std::printf("control latency behind %d bulk messages : worst %lld ns over %d messages\n",
+                bulkCount, (long long)worstLatency.count(), controlCount);
+}
+
+TEST(GPMDispatchLanesTest, CancelDomainDropsEverySessionOfTheDomain) {
+    Lanes lanes;
+    lanes.push(1, "GPM_WEBVIEW", "GPM_WEBVIEW/0", gpm::DispatchPriorityBulk, false);
+    lanes.push(2, "GPM_WEBVIEW", "GPM_WEBVIEW/1", gpm::DispatchPriorityBulk, false);
+    lanes.push(3, "OTHER", "OTHER", gpm::DispatchPriorityBulk, false);
+    lanes.push(4, "GPM_WEBVIEW", "GPM_WEBVIEW/1", gpm::DispatchPriorityControl, false);
+    lanes.cancelDomain("GPM_WEBVIEW");
+    lanes.push(5, "GPM_WEBVIEW", "GPM_WEBVIEW/0", gpm::DispatchPriorityBulk, false);
+
+    std::vector<int> values = drain(lanes);
+    ASSERT_EQ(3u, values.size());
+    EXPECT_EQ(4, values[0]);
+    EXPECT_EQ(3, values[1]);
+    EXPECT_EQ(5, values[2]);
+    EXPECT_EQ(2u, lanes.droppedCount());
+}
@@ -0,0 +1,207 @@
+#include "GPMPluginLoader.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+struct Plugin {
+    std::string domain;
+};
+
+// Same shape as GPMCommunicatorPluginEntry.
+struct Entry {
+    const char* domain;
+    const char* className;
+    Plugin* (*create)(void);
+};
+
+std::atomic<size_t> createdCount(0);
+std::vector<std::unique_ptr<Plugin> > createdPlugins;
+std::mutex createdMutex;
+
+Plugin* createPlugin(const char* domain) {
+    createdCount.fetch_add(1, std::memory_order_relaxed);
+    Plugin* plugin = new Plugin();
+    plugin->domain = domain;
+    std::lock_guard<std::mutex> lock(createdMutex);
+    createdPlugins.push_back(std::unique_ptr<Plugin>(plugin));
+    return plugin;
+}
+
+}
+
+// The host counterpart of GPM_COMMUNICATOR_REGISTER_PLUGIN: an ELF section the linker bounds with __start_ and __stop_.
+// The alignment is pinned so the compiler does not pad entries apart.
+#define GPM_TEST_REGISTER_PLUGIN(pluginDomain, pluginClass) \
+    static Plugin* create##pluginClass(void) { return createPlugin(pluginDomain); } \
+    __attribute__((used, section("gpm_plugins"), aligned(sizeof(void*)))) \
+    static const Entry entry##pluginClass = { pluginDomain, #pluginClass, &create##pluginClass };
+
+#define GPM_TEST_REGISTER_PLUGINS_8(prefix) \
+    GPM_TEST_REGISTER_PLUGIN(#prefix "_0", prefix##0) \
+    GPM_TEST_REGISTER_PLUGIN(#prefix "_1", prefix##1) \
+    GPM_TEST_REGISTER_PLUGIN(#prefix "_2", prefix##2) \
+    GPM_TEST_REGISTER_PLUGIN(#prefix "_3", prefix##3) \
+    GPM_TEST_REGISTER_PLUGIN(#prefix "_4", prefix##4) \
+    GPM_TEST_REGISTER_PLUGIN(#prefix "_5", prefix##5) \
+    GPM_TEST_REGISTER_PLUGIN(#prefix "_6", prefix##6) \
+    GPM_TEST_REGISTER_PLUGIN(#prefix "_7", prefix##7)
+
+GPM_TEST_REGISTER_PLUGIN("GPM_WEBVIEW", WebViewPlugin)
+GPM_TEST_REGISTER_PLUGIN("GPM_SHARED", SharedPluginA)
+GPM_TEST_REGISTER_PLUGIN("GPM_SHARED", SharedPluginB)
+GPM_TEST_REGISTER_PLUGINS_8(DOMAIN_A)
+GPM_TEST_REGISTER_PLUGINS_8(DOMAIN_B)
+GPM_TEST_REGISTER_PLUGINS_8(DOMAIN_C)
+GPM_TEST_REGISTER_PLUGINS_8(DOMAIN_D)
+GPM_TEST_REGISTER_PLUGINS_8(DOMAIN_E)
+GPM_TEST_REGISTER_PLUGINS_8(DOMAIN_F)
+GPM_TEST_REGISTER_PLUGINS_8(DOMAIN_G)
+GPM_TEST_REGISTER_PLUGINS_8(DOMAIN_H)
+
+extern "C" const Entry __start_gpm_plugins[];
+extern "C" const Entry __stop_gpm_plugins[];
+
+namespace {
+
+typedef gpm::PluginLoader<Entry> Loader;
+
+size_t sectionEntryCount() {
+    return (size_t)(__stop_gpm_plugins - __start_gpm_plugins);
+}
+
+// What GPMPluginRegistry loadPluginWithDomain: passes to the loader.
+bool loadDomain(Loader& loader, const std::string& domain, size_t* created = NULL) {
+    size_t count = 0;
+    bool loaded = loader.load(domain, [&](const Entry& entry) {
+        return std::strcmp(entry.domain, domain.c_str()) == 0;
+    }, [&](const Entry& entry) {
+        count++;
+        return entry.create() != NULL;
+    });
+    if(created != NULL) {
+        *created = count;
+    }
+    return loaded;
+}
+
+}
+
+TEST(GPMPluginLoaderTest, ReadsEveryRegisteredEntry) {
+    EXPECT_EQ(3u + 8 * 8, sectionEntryCount());
+}
+
+TEST(GPMPluginLoaderTest, CreatesDomainPluginsOnce) {
+    Loader loader(__start_gpm_plugins, sectionEntryCount());
+    size_t created = 0;
+
+    EXPECT_TRUE(loadDomain(loader, "GPM_SHARED", &created));
+    EXPECT_EQ(2u, created);
+    EXPECT_FALSE(loadDomain(loader, "GPM_SHARED", &created));
+    EXPECT_EQ(0u, created);
+    EXPECT_TRUE(loader.isTried("GPM_SHARED"));
+}
+
+TEST(GPMPluginLoaderTest, RemembersDomainsWithoutPlugin) {
+    Loader loader(__start_gpm_plugins, sectionEntryCount());
+    size_t created = 0;
+
+    EXPECT_FALSE(loadDomain(loader, "UNKNOWN", &created));
+    EXPECT_EQ(0u, created);
+    EXPECT_TRUE(loader.isTried("UNKNOWN"));
+}
+
+TEST(GPMPluginLoaderTest, LookupFromPluginInitReturnsAtOnce) {
+    Loader loader(__start_gpm_plugins, sectionEntryCount());
+    bool nested = true;
+
+    bool loaded = loader.load("GPM_WEBVIEW", [](const Entry& entry) {
+        return std::strcmp(entry.domain, "GPM_WEBVIEW") == 0;
+    }, [&](const Entry& entry) {
+        // As a plugin init that looks up its own domain before its receiver is added.
+        nested = loadDomain(loader, "GPM_WEBVIEW");
+        return entry.create() != NULL;
+    });
+
+    EXPECT_TRUE(loaded);
+    EXPECT_FALSE(nested);
+}
+
+// Run with GPM_NATIVE_TESTS_TSAN=ON to check the wait for a domain created on another thread.
+TEST(GPMPluginLoaderTest, ConcurrentMissesCreateOnce) {
+    const int threadCount = 8;
+    Loader loader(__start_gpm_plugins, sectionEntryCount());
+    std::atomic<size_t> totalCreated(0);
+    std::atomic<int> lookAgainCount(0);
+
+    std::vector<std::thread> threads;
+    for(int thread = 0; thread < threadCount; thread++) {
+        threads.push_back(std::thread([&]() {
+            size_t created = 0;
+            if(loadDomain(loader, "DOMAIN_C_3", &created) == true) {
+                lookAgainCount.fetch_add(1, std::memory_order_relaxed);
+            }
+            totalCreated.fetch_add(created, std::memory_order_relaxed);
+        }));
+    }
+    for(size_t index = 0; index < threads.size(); index++) {
+        threads[index].join();
+    }
+
+    EXPECT_EQ(1u, totalCreated.load());
+    // The creating thread and every thread that waited for it look again; threads arriving later do not need to.
+    EXPECT_GE(lookAgainCount.load(), 1);
+}
+
+// Startup reads the section bounds only. Each domain pays one table scan and its creates on its first lookup,
+// and later misses of a domain without receivers are a set lookup.
+TEST(GPMPluginLoaderTest, BenchmarkLazyCreateAgainstStartupCreate) {
+    const int repeatCount = 200;
+    const size_t entryCount = sectionEntryCount();
+
+    std::chrono::nanoseconds startupElapsed(0);
+    std::chrono::nanoseconds firstLookupElapsed(0);
+    std::chrono::nanoseconds eagerElapsed(0);
+    std::chrono::nanoseconds missElapsed(0);
+    size_t missCount = 0;
+
+    for(int repeat = 0; repeat < repeatCount; repeat++) {
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        Loader loader(__start_gpm_plugins, entryCount);
+        startupElapsed += std::chrono::steady_clock::now() - start;
+
+        start = std::chrono::steady_clock::now();
+        ASSERT_TRUE(loadDomain(loader, "GPM_WEBVIEW"));
+        firstLookupElapsed += std::chrono::steady_clock::now() - start;
+
+        start = std::chrono::steady_clock::now();
+        for(int miss = 0; miss < 100; miss++) {
+            loadDomain(loader, "GPM_WEBVIEW");
+            missCount++;
+        }
+        missElapsed += std::chrono::steady_clock::now() - start;
+
+        // What the class-name path did at startup: every registered plugin created up front.
+        start = std::chrono::steady_clock::now();
+        for(size_t index = 0; index < entryCount; index++) {
+            __start_gpm_plugins[index].create();
+        }
+        eagerElapsed += std::chrono::steady_clock::now() - start;
+
+        std::lock_guard<std::mutex> lock(createdMutex);
+        createdPlugins.clear();
+    }
+
+    std::printf("%zu registered plugins : startup %.1f ns, first lookup %.1f ns, repeated miss %.1f ns; creating all at startup %.1f ns\n",
+                entryCount, (double)startupElapsed.count() / repeatCount, (double)firstLookupElapsed.count() / repeatCount,
+                (double)missElapsed.count() / missCount, (double)eagerElapsed.count() / repeatCount);
+}
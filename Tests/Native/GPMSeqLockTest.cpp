@@ -0,0 +1,186 @@
+#include "GPMSeqLock.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// Same layout as GPMWebViewState.
+struct State {
+    int32_t isActive;
+    int32_t canGoBack;
+    int32_t canGoForward;
+    int32_t x;
+    int32_t y;
+    int32_t width;
+    int32_t height;
+};
+
+State makeState(int32_t value) {
+    State state = { value & 1, value & 1, value & 1, value, value, value, value };
+    return state;
+}
+
+bool isConsistent(const State& state) {
+    int32_t flag = state.x & 1;
+    return state.isActive == flag && state.canGoBack == flag && state.canGoForward == flag &&
+           state.y == state.x && state.width == state.x && state.height == state.x;
+}
+
+}
+
+TEST(GPMSeqLockTest, StartsZeroed) {
+    gpm::SeqLock<State> seqLock;
+    State state = seqLock.load();
+    EXPECT_EQ(0, state.isActive);
+    EXPECT_EQ(0, state.width);
+}
+
+TEST(GPMSeqLockTest, ReadsLastPublishedValue) {
+    gpm::SeqLock<State> seqLock;
+    seqLock.store(makeState(41));
+    seqLock.store(makeState(42));
+
+    State state = seqLock.load();
+    EXPECT_TRUE(isConsistent(state));
+    EXPECT_EQ(42, state.x);
+}
+
+// Run with GPM_NATIVE_TESTS_TSAN=ON to check the reader and writer paths for data races.
+TEST(GPMSeqLockTest, NeverReturnsTornState) {
+    const int readerCount = 4;
+    const int32_t publishCount = 100000;
+
+    gpm::SeqLock<State> seqLock;
+    std::atomic<bool> done(false);
+    std::atomic<int> startedCount(0);
+    std::atomic<size_t> tornReads(0);
+    std::atomic<size_t> readCount(0);
+
+    std::vector<std::thread> readers;
+    for(int reader = 0; reader < readerCount; reader++) {
+        readers.push_back(std::thread([&]() {
+            size_t reads = 0;
+            int32_t last = 0;
+            startedCount.fetch_add(1, std::memory_order_release);
+            while(done.load(std::memory_order_acquire) == false) {
+                State state = seqLock.load();
+                if(isConsistent(state) == false || state.x < last) {
+                    tornReads.fetch_add(1, std::memory_order_relaxed);
+                }
+                last = state.x;
+                reads++;
+            }
+            readCount.fetch_add(reads, std::memory_order_relaxed);
+        }));
+    }
+
+    while(startedCount.load(std::memory_order_acquire) < readerCount) {
+        std::this_thread::yield();
+    }
+    for(int32_t value = 1; value <= publishCount; value++) {
+        seqLock.store(makeState(value));
+        if(value % 1000 == 0) {
+            std::this_thread::yield();
+        }
+    }
+
+    done.store(true, std::memory_order_release);
+    for(size_t index = 0; index < readers.size(); index++) {
+        readers[index].join();
+    }
+
+    EXPECT_EQ(0u, tornReads.load());
+    EXPECT_GT(readCount.load(), 0u);
+    EXPECT_EQ(publishCount, seqLock.load().x);
+}
+
+// One snapshot read against the six sync getters it replaces. Each getter is one onRequestSync round trip:
+// the request JSON is built and copied across, the native side finds the scheme and instanceId in it
+// and formats domain, data and extra with the delimiter, and the managed side splits that and parses the value.
+// Both sides are plain C++ strings here, without NSString, NSJSONSerialization or managed strings,
+// so the six calls are still measured below their real cost.
+TEST(GPMSeqLockTest, BenchmarkSnapshotAgainstSixSyncCalls) {
+    const int iterationCount = 200000;
+    const std::string delimiter = "${gpm_communicator}";
+    const char* const schemes[] = {
+        "gpmwebview://canGoBack", "gpmwebview://canGoForward",
+        "gpmwebview://getX", "gpmwebview://getY", "gpmwebview://getWidth", "gpmwebview://getHeight"
+    };
+
+    gpm::SeqLock<State> seqLock(makeState(7));
+
+    // The native half of onRequestSync, answering from the snapshot as GPMWebViewPlugin onSyncMessage: does.
+    auto onRequestSync = [&](const char* domain, const char* data, const char* extra) {
+        std::string request(data);
+        size_t schemeStart = request.find("\"scheme\":\"") + 10;
+        std::string scheme = request.substr(schemeStart, request.find('"', schemeStart) - schemeStart);
+        long instanceId = std::strtol(request.c_str() + request.find("\"instanceId\":") + 13, NULL, 10);
+
+        State state = seqLock.load();
+        std::string value;
+        if(instanceId != 0) {
+            value = "0";
+        } else if(scheme == schemes[0]) {
+            value = (state.canGoBack != 0) ? "true" : "false";
+        } else if(scheme == schemes[1]) {
+            value = (state.canGoForward != 0) ? "true" : "false";
+        } else if(scheme == schemes[2]) {
+            value = std::to_string(state.x);
+        } else if(scheme == schemes[3]) {
+            value = std::to_string(state.y);
+        } else if(scheme == schemes[4]) {
+            value = std::to_string(state.width);
+        } else if(scheme == schemes[5]) {
+            value = std::to_string(state.height);
+        }
+
+        std::string response = std::string(domain) + delimiter + value + delimiter + extra;
+        return strdup(response.c_str());
+    };
+
+    // The managed half: NativeWebView CallSync and Communicator CallSync.
+    auto callSync = [&](const char* scheme) {
+        std::string request = std::string("{\"scheme\":\"") + scheme +
+                              "\",\"error\":null,\"data\":null,\"extra\":null,\"callback\":0,\"callbackType\":0,\"instanceId\":0}";
+        char* responseChars = onRequestSync("GPM_WEBVIEW", request.c_str(), "");
+        std::string response(responseChars);
+        std::free(responseChars);
+
+        size_t dataStart = response.find(delimiter) + delimiter.size();
+        std::string data = response.substr(dataStart, response.find(delimiter, dataStart) - dataStart);
+        if(data == "true" || data == "false") {
+            return (int32_t)(data == "true");
+        }
+        return (int32_t)std::strtol(data.c_str(), NULL, 10);
+    };
+
+    int64_t sum = 0;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for(int iteration = 0; iteration < iterationCount; iteration++) {
+        State state = seqLock.load();
+        sum += state.canGoBack + state.canGoForward + state.x + state.y + state.width + state.height;
+    }
+    std::chrono::nanoseconds snapshotElapsed = std::chrono::steady_clock::now() - start;
+
+    start = std::chrono::steady_clock::now();
+    for(int iteration = 0; iteration < iterationCount; iteration++) {
+        for(size_t index = 0; index < 6; index++) {
+            sum += callSync(schemes[index]);
+        }
+    }
+    std::chrono::nanoseconds callsElapsed = std::chrono::steady_clock::now() - start;
+
+    EXPECT_EQ((int64_t)iterationCount * 2 * (2 + 4 * 7), sum);
+    std::printf("state read : snapshot %.1f ns, six sync calls %.1f ns\n",
+                (double)snapshotElapsed.count() / iterationCount, (double)callsElapsed.count() / iterationCount);
+}
@@ -0,0 +1,290 @@
+#include "GPMSnapshotCell.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+const uint32_t LIVE = 0x600DF00Du;
+const uint32_t FREED = 0xDEADBEEFu;
+
+// Domain -> receivers, shaped like the communicator's receiver registry.
+struct Registry {
+    uint32_t canary;
+    uint64_t version;
+    std::unordered_map<std::string, std::vector<int> > receivers;
+};
+
+// Poisons instead of freeing, so a reader that outlives its snapshot sees the canary change.
+struct PoisonDeleter {
+    std::atomic<size_t>* freedCount;
+
+    void operator()(Registry* registry) const {
+        registry->canary = FREED;
+        freedCount->fetch_add(1, std::memory_order_relaxed);
+    }
+};
+
+typedef gpm::SnapshotCell<Registry, PoisonDeleter> Cell;
+
+struct Fixture {
+    std::atomic<size_t> freedCount;
+    std::vector<Registry*> allocated;
+    std::mutex allocatedMutex;
+
+    Fixture() : freedCount(0) {
+    }
+
+    ~Fixture() {
+        for(size_t index = 0; index < allocated.size(); index++) {
+            delete allocated[index];
+        }
+    }
+
+    Registry* make(const Registry* source) {
+        Registry* registry = (source != nullptr) ? new Registry(*source) : new Registry();
+        registry->canary = LIVE;
+        registry->version = (source != nullptr) ? source->version + 1 : 0;
+        std::lock_guard<std::mutex> lock(allocatedMutex);
+        allocated.push_back(registry);
+        return registry;
+    }
+
+    PoisonDeleter deleter() {
+        PoisonDeleter deleter = { &freedCount };
+        return deleter;
+    }
+};
+
+std::string domainName(int index) {
+    return "DOMAIN_" + std::to_string(index);
+}
+
+}
+
+TEST(GPMSnapshotCellTest, ReadsPublishedSnapshot) {
+    Fixture fixture;
+    Cell cell(fixture.make(nullptr), fixture.deleter());
+
+    cell.update([&](Registry* current) {
+        Registry* next = fixture.make(current);
+        next->receivers["GPM_WEBVIEW"].push_back(1);
+        return next;
+    });
+
+    Cell::ReadGuard guard(cell);
+    EXPECT_EQ(1u, guard.get()->version);
+    EXPECT_EQ(1u, guard.get()->receivers.count("GPM_WEBVIEW"));
+}
+
+TEST(GPMSnapshotCellTest, KeepsSnapshotWhileReaderHoldsIt) {
+    Fixture fixture;
+    Cell cell(fixture.make(nullptr), fixture.deleter());
+
+    Cell::ReadGuard* guard = new Cell::ReadGuard(cell);
+    const Registry* held = guard->get();
+
+    for(int index = 0; index < 4; index++) {
+        cell.update([&](Registry* current) { return fixture.make(current); });
+        cell.reclaim();
+    }
+    EXPECT_EQ(LIVE, held->canary);
+
+    delete guard;
+    cell.reclaim();
+    EXPECT_EQ(FREED, held->canary);
+    EXPECT_EQ(0u, cell.retiredCount());
+    EXPECT_EQ(4u, fixture.freedCount.load());
+}
+
+// A guard held on one thread counts in its own stripe, and more threads than stripes share them.
+TEST(GPMSnapshotCellTest, KeepsSnapshotHeldOnAnotherThread) {
+    Fixture fixture;
+    Cell cell(fixture.make(nullptr), fixture.deleter());
+
+    std::atomic<int> stage(0);
+    const Registry* held = nullptr;
+    std::thread holder([&]() {
+        Cell::ReadGuard guard(cell);
+        held = guard.get();
+        stage.store(1, std::memory_order_release);
+        while(stage.load(std::memory_order_acquire) != 2) {
+            std::this_thread::yield();
+        }
+    });
+    while(stage.load(std::memory_order_acquire) != 1) {
+        std::this_thread::yield();
+    }
+
+    std::vector<std::thread> readers;
+    for(size_t reader = 0; reader < gpm::SNAPSHOT_READER_STRIPE_COUNT + 4; reader++) {
+        readers.push_back(std::thread([&]() {
+            Cell::ReadGuard guard(cell);
+            EXPECT_EQ(LIVE, guard.get()->canary);
+        }));
+    }
+    for(size_t index = 0; index < readers.size(); index++) {
+        readers[index].join();
+    }
+
+    for(int index = 0; index < 4; index++) {
+        cell.update([&](Registry* current) { return fixture.make(current); });
+        cell.reclaim();
+    }
+    EXPECT_EQ(LIVE, held->canary);
+
+    stage.store(2, std::memory_order_release);
+    holder.join();
+    cell.reclaim();
+    EXPECT_EQ(FREED, held->canary);
+    EXPECT_EQ(0u, cell.retiredCount());
+}
+
+TEST(GPMSnapshotCellTest, ReclaimsRetiredSnapshotsAtQuiescentPoint) {
+    Fixture fixture;
+    Cell cell(fixture.make(nullptr), fixture.deleter());
+
+    const size_t updateCount = 1000;
+    for(size_t index = 0; index < updateCount; index++) {
+        cell.update([&](Registry* current) { return fixture.make(current); });
+    }
+    cell.reclaim();
+
+    EXPECT_EQ(0u, cell.retiredCount());
+    EXPECT_EQ(updateCount, fixture.freedCount.load());
+}
+
+TEST(GPMSnapshotCellTest, KeepsSnapshotWhenUpdateReturnsNull) {
+    Fixture fixture;
+    Cell cell(fixture.make(nullptr), fixture.deleter());
+
+    EXPECT_FALSE(cell.update([](Registry*) { return (Registry*)nullptr; }));
+    EXPECT_EQ(0u, cell.retiredCount());
+}
+
+// Run with GPM_NATIVE_TESTS_TSAN=ON to check the reader and writer paths for data races.
+TEST(GPMSnapshotCellTest, ConcurrentRegisterAndLookup) {
+    Fixture fixture;
+    Cell cell(fixture.make(nullptr), fixture.deleter());
+
+    const int readerCount = 4;
+    const int domainCount = 200;
+    std::atomic<bool> done(false);
+    std::atomic<int> startedCount(0);
+    std::atomic<size_t> poisonedReads(0);
+    std::atomic<size_t> lookupCount(0);
+
+    std::vector<std::thread> readers;
+    for(int reader = 0; reader < readerCount; reader++) {
+        readers.push_back(std::thread([&, reader]() {
+            size_t lookups = 0;
+            uint64_t lastVersion = 0;
+            startedCount.fetch_add(1, std::memory_order_release);
+            while(done.load(std::memory_order_acquire) == false) {
+                Cell::ReadGuard guard(cell);
+                const Registry* registry = guard.get();
+                if(registry->canary != LIVE || registry->version < lastVersion) {
+                    poisonedReads.fetch_add(1, std::memory_order_relaxed);
+                }
+                lastVersion = registry->version;
+                registry->receivers.find(domainName((int)(lookups + reader) % domainCount));
+                lookups++;
+            }
+            lookupCount.fetch_add(lookups, std::memory_order_relaxed);
+        }));
+    }
+
+    std::thread quiescent([&]() {
+        while(done.load(std::memory_order_acquire) == false) {
+            cell.reclaim();
+            std::this_thread::yield();
+        }
+    });
+
+    while(startedCount.load(std::memory_order_acquire) < readerCount) {
+        std::this_thread::yield();
+    }
+    for(int domain = 0; domain < domainCount; domain++) {
+        cell.update([&](Registry* current) {
+            Registry* next = fixture.make(current);
+            next->receivers[domainName(domain)].push_back(domain);
+            return next;
+        });
+        std::this_thread::yield();
+    }
+
+    done.store(true, std::memory_order_release);
+    for(size_t index = 0; index < readers.size(); index++) {
+        readers[index].join();
+    }
+    quiescent.join();
+    cell.reclaim();
+
+    EXPECT_EQ(0u, poisonedReads.load());
+    EXPECT_GT(lookupCount.load(), 0u);
+    EXPECT_EQ(0u, cell.retiredCount());
+    EXPECT_EQ((size_t)domainCount, fixture.freedCount.load());
+
+    Cell::ReadGuard guard(cell);
+    EXPECT_EQ((size_t)domainCount, guard.get()->receivers.size());
+}
+
+// Lookup cost with 8 threads reading a 64 domain registry, against the same map behind a mutex.
+TEST(GPMSnapshotCellTest, BenchmarkLookupUnderEightThreads) {
+    const int threadCount = 8;
+    const int lookupsPerThread = 200000;
+    const int domainCount = 64;
+
+    Fixture fixture;
+    Registry* initial = fixture.make(nullptr);
+    for(int domain = 0; domain < domainCount; domain++) {
+        initial->receivers[domainName(domain)].push_back(domain);
+    }
+    Cell cell(initial, fixture.deleter());
+    std::mutex mutex;
+
+    std::vector<std::string> keys;
+    for(int domain = 0; domain < domainCount; domain++) {
+        keys.push_back(domainName(domain));
+    }
+
+    auto run = [&](bool locked) {
+        std::atomic<size_t> found(0);
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        std::vector<std::thread> threads;
+        for(int thread = 0; thread < threadCount; thread++) {
+            threads.push_back(std::thread([&, thread]() {
+                size_t hits = 0;
+                for(int lookup = 0; lookup < lookupsPerThread; lookup++) {
+                    const std::string& key = keys[(lookup + thread) % domainCount];
+                    if(locked == true) {
+                        std::lock_guard<std::mutex> lock(mutex);
+                        hits += initial->receivers.count(key);
+                    } else {
+                        Cell::ReadGuard guard(cell);
+                        hits += guard.get()->receivers.count(key);
+                    }
+                }
+                found.fetch_add(hits, std::memory_order_relaxed);
+            }));
+        }
+        for(size_t index = 0; index < threads.size(); index++) {
+            threads[index].join();
+        }
+        EXPECT_EQ((size_t)threadCount * lookupsPerThread, found.load());
+        std::chrono::nanoseconds elapsed = std::chrono::steady_clock::now() - start;
+        return (double)elapsed.count() / ((double)threadCount * lookupsPerThread);
+    };
+
+    double snapshotNs = run(false);
+    double mutexNs = run(true);
+    std::printf("lookup under %d threads : snapshot %.1f ns, mutex %.1f ns per lookup\n", threadCount, snapshotNs, mutexNs);
+}
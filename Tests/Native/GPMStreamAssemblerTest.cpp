@@ -0,0 +1,194 @@
+#include "GPMStreamAssembler.h"
+
+#include <gtest/gtest.h>
+#include <sys/resource.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(__SANITIZE_THREAD__)
+#define GPM_TEST_TSAN 1
+#elif defined(__has_feature)
+#if __has_feature(thread_sanitizer)
+#define GPM_TEST_TSAN 1
+#endif
+#endif
+
+namespace {
+
+// Same bounds as GPMMessageStreamAssembler.mm, and the chunk length of the managed side.
+const size_t MAX_LENGTH = 64 * 1024 * 1024;
+const size_t MAX_IN_FLIGHT_LENGTH = 96 * 1024 * 1024;
+const size_t MAX_COUNT = 8;
+const size_t CHUNK_LENGTH = 256 * 1024;
+
+struct Meta {
+    std::string domain;
+    std::string extra;
+};
+
+typedef gpm::StreamAssembler<Meta> Assembler;
+
+Meta makeMeta(const std::string& domain) {
+    Meta meta;
+    meta.domain = domain;
+    meta.extra = "extra";
+    return meta;
+}
+
+long peakResidentKilobytes() {
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss;
+}
+
+}
+
+// First in the file, so the peak resident size is not raised by another test of this binary.
+TEST(GPMStreamAssemblerTest, Transfers20MegabytesInOneBuffer) {
+    const size_t payloadLength = 20 * 1024 * 1024;
+
+    std::string payload(payloadLength, ' ');
+    for(size_t index = 0; index < payloadLength; index++) {
+        payload[index] = (char)('a' + index % 26);
+    }
+
+    Assembler assembler(MAX_LENGTH, MAX_IN_FLIGHT_LENGTH, MAX_COUNT);
+    long baselineKilobytes = peakResidentKilobytes();
+
+    std::chrono::nanoseconds worstCall(0);
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    long streamId = 0;
+    ASSERT_EQ(Assembler::BEGUN, assembler.begin(makeMeta("DOMAIN"), payloadLength, streamId));
+    worstCall = std::max(worstCall, std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start));
+
+    size_t chunkCount = 0;
+    for(size_t offset = 0; offset < payloadLength; offset += CHUNK_LENGTH) {
+        Assembler::Progress progress;
+        std::chrono::steady_clock::time_point callStart = std::chrono::steady_clock::now();
+        ASSERT_EQ(Assembler::APPENDED, assembler.append(streamId, payload.data() + offset, std::min(CHUNK_LENGTH, payloadLength - offset), progress));
+        worstCall = std::max(worstCall, std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - callStart));
+        EXPECT_EQ(std::min(offset + CHUNK_LENGTH, payloadLength), progress.received);
+        chunkCount++;
+    }
+
+    Assembler::Completed completed;
+    std::chrono::steady_clock::time_point endStart = std::chrono::steady_clock::now();
+    ASSERT_EQ(Assembler::ENDED, assembler.end(streamId, completed));
+    worstCall = std::max(worstCall, std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - endStart));
+    std::chrono::nanoseconds totalElapsed = std::chrono::steady_clock::now() - start;
+
+    long growthKilobytes = peakResidentKilobytes() - baselineKilobytes;
+    EXPECT_EQ(payloadLength, completed.length);
+    EXPECT_EQ(0, std::memcmp(payload.data(), completed.buffer, payloadLength));
+    EXPECT_EQ("DOMAIN", completed.meta.domain);
+    EXPECT_EQ(0u, assembler.streamCount());
+    EXPECT_EQ(0u, assembler.inFlightLength());
+    std::free(completed.buffer);
+
+    std::printf("20 MB stream : %zu chunks, peak RSS +%ld KB, worst call %.1f us, total %.1f ms\n",
+                chunkCount, growthKilobytes, (double)worstCall.count() / 1000.0, (double)totalElapsed.count() / 1000000.0);
+
+#ifndef GPM_TEST_TSAN
+    // One buffer of the payload, never a second copy while it grows.
+    EXPECT_LT(growthKilobytes, (long)(payloadLength * 5 / 4 / 1024));
+#endif
+    // A chunk is one copy of 256 KB, far below a frame.
+    EXPECT_LT(worstCall.count(), 50 * 1000 * 1000);
+}
+
+TEST(GPMStreamAssemblerTest, RejectsInvalidLengths) {
+    Assembler assembler(1024, 4096, 2);
+    long streamId = 0;
+
+    EXPECT_EQ(Assembler::INVALID_LENGTH, assembler.begin(makeMeta("DOMAIN"), 0, streamId));
+    EXPECT_EQ(Assembler::INVALID_LENGTH, assembler.begin(makeMeta("DOMAIN"), 1025, streamId));
+    EXPECT_EQ(0u, assembler.streamCount());
+}
+
+TEST(GPMStreamAssemblerTest, BoundsStreamsInFlight) {
+    Assembler assembler(1024, 1536, 2);
+    long first = 0;
+    long second = 0;
+    long third = 0;
+
+    ASSERT_EQ(Assembler::BEGUN, assembler.begin(makeMeta("DOMAIN"), 1024, first));
+    EXPECT_EQ(Assembler::TOO_MANY_STREAMS, assembler.begin(makeMeta("DOMAIN"), 1024, second));
+    ASSERT_EQ(Assembler::BEGUN, assembler.begin(makeMeta("DOMAIN"), 512, second));
+    EXPECT_EQ(Assembler::TOO_MANY_STREAMS, assembler.begin(makeMeta("DOMAIN"), 1, third));
+    EXPECT_NE(first, second);
+    EXPECT_EQ(1536u, assembler.inFlightLength());
+
+    Meta meta;
+    EXPECT_TRUE(assembler.abort(first, meta));
+    EXPECT_FALSE(assembler.abort(first, meta));
+    EXPECT_EQ(512u, assembler.inFlightLength());
+    EXPECT_EQ(Assembler::BEGUN, assembler.begin(makeMeta("DOMAIN"), 1, third));
+}
+
+TEST(GPMStreamAssemblerTest, RejectsOverflowAndEarlyEnd) {
+    Assembler assembler(MAX_LENGTH, MAX_IN_FLIGHT_LENGTH, MAX_COUNT);
+    const char bytes[8] = { 'a', 'b', 'c', 'd', 'e', 'f', 'g', 'h' };
+    long streamId = 0;
+    Assembler::Progress progress;
+    Assembler::Completed completed;
+
+    ASSERT_EQ(Assembler::BEGUN, assembler.begin(makeMeta("DOMAIN"), 4, streamId));
+    EXPECT_EQ(Assembler::TOO_LONG, assembler.append(streamId, bytes, 8, progress));
+    EXPECT_EQ(Assembler::APPENDED, assembler.append(streamId, bytes, 3, progress));
+    EXPECT_EQ(Assembler::INCOMPLETE, assembler.end(streamId, completed));
+
+    // Both failures leave the stream to the caller's abort.
+    Meta meta;
+    EXPECT_TRUE(assembler.abort(streamId, meta));
+    EXPECT_EQ("DOMAIN", meta.domain);
+    EXPECT_EQ(Assembler::NO_STREAM, assembler.append(streamId, bytes, 1, progress));
+    EXPECT_EQ(Assembler::UNKNOWN_STREAM, assembler.end(streamId, completed));
+    EXPECT_EQ(0u, assembler.inFlightLength());
+}
+
+// Run with GPM_NATIVE_TESTS_TSAN=ON to check concurrent streams for data races.
+TEST(GPMStreamAssemblerTest, AssemblesConcurrentStreams) {
+    const int senderCount = 4;
+    const size_t payloadLength = 1024 * 1024 + 3;
+
+    Assembler assembler(MAX_LENGTH, MAX_IN_FLIGHT_LENGTH, MAX_COUNT);
+    std::vector<std::thread> senders;
+    std::vector<int> matched(senderCount, 0);
+
+    for(int sender = 0; sender < senderCount; sender++) {
+        senders.push_back(std::thread([&, sender]() {
+            std::string payload(payloadLength, (char)('a' + sender));
+            long streamId = 0;
+            if(assembler.begin(makeMeta("DOMAIN" + std::to_string(sender)), payloadLength, streamId) != Assembler::BEGUN) {
+                return;
+            }
+            for(size_t offset = 0; offset < payloadLength; offset += CHUNK_LENGTH / 4) {
+                Assembler::Progress progress;
+                assembler.append(streamId, payload.data() + offset, std::min(CHUNK_LENGTH / 4, payloadLength - offset), progress);
+            }
+            Assembler::Completed completed;
+            if(assembler.end(streamId, completed) == Assembler::ENDED) {
+                matched[sender] = completed.meta.domain == "DOMAIN" + std::to_string(sender) &&
+                                  std::memcmp(payload.data(), completed.buffer, payloadLength) == 0;
+                std::free(completed.buffer);
+            }
+        }));
+    }
+    for(size_t index = 0; index < senders.size(); index++) {
+        senders[index].join();
+    }
+
+    for(int sender = 0; sender < senderCount; sender++) {
+        EXPECT_EQ(1, matched[sender]) << sender;
+    }
+    EXPECT_EQ(0u, assembler.streamCount());
+    EXPECT_EQ(0u, assembler.inFlightLength());
+}
@@ -0,0 +1,144 @@
+#include "GPMDispatchLanes.h"
+#include "GPMSnapshotCell.h"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+const char* const DOMAIN = "GPM_WEBVIEW";
+
+// Read-only once queued, as GPMCommunicatorReadOnlyMessage.
+struct Message {
+    std::string domain;
+    std::string data;
+    std::string extra;
+    std::string topic;
+};
+
+typedef std::shared_ptr<const Message> MessageRef;
+
+struct Receiver {
+    std::string topic;
+    std::function<void(const Message&)> onMessage;
+};
+
+// Domain -> receivers, as the communicator's receiver registry.
+typedef std::unordered_map<std::string, std::vector<Receiver> > Registry;
+typedef gpm::SnapshotCell<const Registry> RegistryCell;
+
+void addReceiver(RegistryCell& cell, const std::string& domain, const Receiver& receiver) {
+    cell.update([&](const Registry* current) -> const Registry* {
+        Registry* next = new Registry(*current);
+        (*next)[domain].push_back(receiver);
+        return next;
+    });
+}
+
+// The loop of GPMMessageDispatcher deliverMessage: one registry lookup, then every receiver whose topic matches.
+void deliver(const RegistryCell& cell, const Message& message) {
+    RegistryCell::ReadGuard guard(cell);
+    Registry::const_iterator found = guard.get()->find(message.domain);
+    if(found == guard.get()->end()) {
+        return;
+    }
+    for(size_t index = 0; index < found->second.size(); index++) {
+        const Receiver& receiver = found->second[index];
+        if(receiver.topic.empty() == false && receiver.topic != message.topic) {
+            continue;
+        }
+        receiver.onMessage(message);
+    }
+}
+
+// Dispatches messageCount messages of payloadLength bytes to subscriberCount receivers.
+// Returns nanoseconds per message. copyPerReceiver hands every receiver its own copy instead of the shared one.
+double dispatchMessages(size_t subscriberCount, size_t messageCount, size_t payloadLength, bool copyPerReceiver, size_t& deliveredBytes) {
+    RegistryCell cell(new Registry());
+    deliveredBytes = 0;
+    for(size_t subscriber = 0; subscriber < subscriberCount; subscriber++) {
+        Receiver receiver;
+        receiver.onMessage = [&deliveredBytes, copyPerReceiver](const Message& message) {
+            if(copyPerReceiver == true) {
+                Message copied(message);
+                deliveredBytes += copied.data.size();
+            } else {
+                deliveredBytes += message.data.size();
+            }
+        };
+        addReceiver(cell, DOMAIN, receiver);
+    }
+
+    Message source;
+    source.domain = DOMAIN;
+    source.data = std::string(payloadLength, 'x');
+    source.extra = "{\"scheme\":\"gpmwebview://setPosition\"}";
+
+    gpm::DispatchLanes<MessageRef> lanes;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for(size_t index = 0; index < messageCount; index++) {
+        // One copy per message when it is queued, as GPMMessageDispatcher dispatchMessage: does.
+        lanes.push(std::make_shared<const Message>(source), DOMAIN, DOMAIN, gpm::DispatchPriorityBulk, false);
+        MessageRef message;
+        while(lanes.pop(message) == true) {
+            deliver(cell, *message);
+        }
+    }
+    std::chrono::nanoseconds elapsed = std::chrono::steady_clock::now() - start;
+    return (double)elapsed.count() / messageCount;
+}
+
+}
+
+TEST(GPMSubscriberFanOutTest, DeliversToMatchingTopicsOnly) {
+    RegistryCell cell(new Registry());
+    std::vector<std::string> received;
+
+    const char* const topics[] = { "", "webViewCallback/1", "webViewCallback/2" };
+    for(size_t index = 0; index < 3; index++) {
+        Receiver receiver;
+        receiver.topic = topics[index];
+        std::string name = topics[index];
+        receiver.onMessage = [&received, name](const Message& message) {
+            received.push_back(name + ":" + message.data);
+        };
+        addReceiver(cell, DOMAIN, receiver);
+    }
+
+    Message message;
+    message.domain = DOMAIN;
+    message.data = "open";
+    message.topic = "webViewCallback/2";
+    deliver(cell, message);
+
+    ASSERT_EQ(2u, received.size());
+    EXPECT_EQ(":open", received[0]);
+    EXPECT_EQ("webViewCallback/2:open", received[1]);
+}
+
+// The message is copied once when queued and shared by every receiver,
+// so going from 1 to 8 subscribers adds only the 7 extra calls, not 7 more copies of the payload.
+TEST(GPMSubscriberFanOutTest, BenchmarkOneAgainstEightSubscribers) {
+    const size_t messageCount = 20000;
+    const size_t payloadLength = 16 * 1024;
+
+    size_t deliveredBytes = 0;
+    double oneSubscriber = dispatchMessages(1, messageCount, payloadLength, false, deliveredBytes);
+    EXPECT_EQ(messageCount * payloadLength, deliveredBytes);
+
+    double eightSubscribers = dispatchMessages(8, messageCount, payloadLength, false, deliveredBytes);
+    EXPECT_EQ(8 * messageCount * payloadLength, deliveredBytes);
+
+    double eightCopies = dispatchMessages(8, messageCount, payloadLength, true, deliveredBytes);
+    EXPECT_EQ(8 * messageCount * payloadLength, deliveredBytes);
+
+    std::printf("16 KB message : 1 subscriber %.1f ns, 8 subscribers %.1f ns, 8 subscribers with a copy each %.1f ns\n",
+                oneSubscriber, eightSubscribers, eightCopies);
+}
@@ -0,0 +1,429 @@
+#include "GPMWebViewInstanceTable.h"
+#include "GPMWebViewRequestRouter.h"
+#include "GPMWebViewStubView.h"
+#include "GPMDispatchLanes.h"
+#include "GPMSeqLock.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+const long INSTANCE_COUNT = 16;
+
+// Same layout as GPMWebViewState.
+struct State {
+    int32_t isActive;
+    int32_t canGoBack;
+    int32_t canGoForward;
+    int32_t x;
+    int32_t y;
+    int32_t width;
+    int32_t height;
+};
+
+// GPMWebViewStubBackend without its callbacks. Compared by pointer, as the plugin compares backend objects.
+struct StubBackend {
+    gpm::WebViewStubView<State> view;
+    size_t scriptCount;
+
+    StubBackend() : scriptCount(0) {
+    }
+};
+
+typedef std::shared_ptr<StubBackend> BackendRef;
+typedef gpm::WebViewInstanceTable<BackendRef, INSTANCE_COUNT> Table;
+typedef gpm::WebViewRequestRouter<BackendRef, INSTANCE_COUNT> Router;
+
+enum RequestKind {
+    SHOW,
+    CLOSE,
+    SET_POSITION,
+    EXECUTE_JAVASCRIPT,
+    SHOW_WEB_BROWSER
+};
+
+struct Request {
+    long instanceId;
+    RequestKind kind;
+    long callback;
+    int32_t value;
+};
+
+enum CallbackType {
+    OPEN = 0,
+    CLOSED = 1,
+    REQUEST_FAILED = 100
+};
+
+struct Callback {
+    long instanceId;
+    long callback;
+    int type;
+    bool hasError;
+};
+
+// The side effects of GPMWebViewPlugin onAsyncMessage: for each route of the shared router,
+// with the stub view's close callback delivered at once as GPMWebViewStubBackend does.
+struct Plugin {
+    Router router;
+    gpm::SeqLock<State> states[INSTANCE_COUNT];
+    std::vector<Callback> callbacks;
+    size_t appRequestCount;
+
+    explicit Plugin(bool singleView) : router(singleView), appRequestCount(0) {
+    }
+
+    static Router::RequestKind kindOf(RequestKind kind) {
+        switch(kind) {
+            case SHOW:
+                return Router::SHOW;
+            case CLOSE:
+                return Router::CLOSE;
+            case SHOW_WEB_BROWSER:
+                return Router::APP_REQUEST;
+            default:
+                return Router::INSTANCE_REQUEST;
+        }
+    }
+
+    void handle(const Request& request) {
+        Router::Entry entry;
+        if(request.kind == SHOW) {
+            entry.backend = std::make_shared<StubBackend>();
+            entry.callback = request.callback;
+        }
+
+        switch(router.route(request.instanceId, kindOf(request.kind), entry)) {
+            case Router::OPEN:
+                entry.backend->view.show(gpm::WebViewStubView<State>::Geometry());
+                publish(request.instanceId, *entry.backend);
+                send(request.instanceId, request.callback, OPEN, false);
+                break;
+            case Router::REFUSE_ALREADY_OPEN:
+            case Router::REFUSE_VIEW_IN_USE:
+                send(request.instanceId, request.callback, OPEN, true);
+                break;
+            case Router::SERVE_APP:
+                appRequestCount++;
+                break;
+            case Router::SERVE_BACKEND:
+                serve(request, entry);
+                break;
+            case Router::FAIL:
+                send(request.instanceId, -1, REQUEST_FAILED, true);
+                break;
+            default:
+                break;
+        }
+    }
+
+    void serve(const Request& request, const Router::Entry& entry) {
+        StubBackend& backend = *entry.backend;
+        switch(request.kind) {
+            case CLOSE:
+                if(backend.view.close() == true && router.close(request.instanceId, entry.backend) == true) {
+                    states[request.instanceId].store(State());
+                }
+                send(request.instanceId, entry.callback, CLOSED, false);
+                break;
+            case SET_POSITION:
+                backend.view.setPosition(request.value, request.value);
+                publish(request.instanceId, backend);
+                break;
+            case EXECUTE_JAVASCRIPT:
+                backend.scriptCount++;
+                break;
+            default:
+                break;
+        }
+    }
+
+    void publish(long instanceId, const StubBackend& backend) {
+        states[instanceId].store(backend.view.state());
+    }
+
+    void send(long instanceId, long callback, int type, bool hasError) {
+        Callback sent = { instanceId, callback, type, hasError };
+        callbacks.push_back(sent);
+    }
+
+    size_t countCallbacks(long instanceId, int type) const {
+        size_t count = 0;
+        for(size_t index = 0; index < callbacks.size(); index++) {
+            if(callbacks[index].instanceId == instanceId && callbacks[index].type == type) {
+                count++;
+            }
+        }
+        return count;
+    }
+};
+
+std::string sessionOf(long instanceId) {
+    return "GPM_WEBVIEW/" + std::to_string(instanceId);
+}
+
+void push(gpm::DispatchLanes<Request>& lanes, long instanceId, RequestKind kind, int32_t value) {
+    Request request = { instanceId, kind, instanceId, value };
+    bool isClose = kind == CLOSE;
+    lanes.push(request, "GPM_WEBVIEW", sessionOf(instanceId),
+               isClose ? gpm::DispatchPriorityControl : gpm::DispatchPriorityBulk, isClose);
+}
+
+void drain(gpm::DispatchLanes<Request>& lanes, Plugin& plugin) {
+    Request request;
+    while(lanes.pop(request) == true) {
+        plugin.handle(request);
+    }
+}
+
+}
+
+TEST(GPMWebViewInstanceTableTest, RejectsInvalidInstance) {
+    Table table(false);
+    Table::Entry entry;
+    entry.backend = std::make_shared<StubBackend>();
+    entry.callback = 1;
+
+    EXPECT_EQ(Table::INVALID_INSTANCE, table.open(-1, entry));
+    EXPECT_EQ(Table::INVALID_INSTANCE, table.open(INSTANCE_COUNT, entry));
+    EXPECT_FALSE(table.find(INSTANCE_COUNT, entry));
+    EXPECT_EQ(0u, table.openCount());
+}
+
+TEST(GPMWebViewInstanceTableTest, OpensInstanceOnce) {
+    Table table(false);
+    Table::Entry first;
+    first.backend = std::make_shared<StubBackend>();
+    first.callback = 1;
+    Table::Entry second;
+    second.backend = std::make_shared<StubBackend>();
+    second.callback = 2;
+
+    EXPECT_EQ(Table::OPENED, table.open(3, first));
+    EXPECT_EQ(Table::ALREADY_OPEN, table.open(3, second));
+
+    Table::Entry found;
+    ASSERT_TRUE(table.find(3, found));
+    EXPECT_EQ(first.backend, found.backend);
+    EXPECT_EQ(1, found.callback);
+}
+
+TEST(GPMWebViewInstanceTableTest, SingleViewOpensOneInstanceAtATime) {
+    Table table(true);
+    Table::Entry first;
+    first.backend = std::make_shared<StubBackend>();
+    Table::Entry second;
+    second.backend = std::make_shared<StubBackend>();
+
+    EXPECT_EQ(Table::OPENED, table.open(1, first));
+    EXPECT_EQ(Table::VIEW_IN_USE, table.open(2, second));
+
+    EXPECT_TRUE(table.close(1, first.backend));
+    EXPECT_EQ(Table::OPENED, table.open(2, second));
+}
+
+TEST(GPMWebViewInstanceTableTest, ClosesOnlyWithOwningBackend) {
+    Table table(false);
+    Table::Entry closed;
+    closed.backend = std::make_shared<StubBackend>();
+    Table::Entry reopened;
+    reopened.backend = std::make_shared<StubBackend>();
+
+    ASSERT_EQ(Table::OPENED, table.open(5, closed));
+    EXPECT_TRUE(table.close(5, closed.backend));
+    ASSERT_EQ(Table::OPENED, table.open(5, reopened));
+
+    // A late close callback of the first view leaves the reopened instance alone.
+    EXPECT_FALSE(table.close(5, closed.backend));
+    EXPECT_EQ(1u, table.openCount());
+    EXPECT_TRUE(table.close(5, reopened.backend));
+    EXPECT_FALSE(table.close(5, reopened.backend));
+}
+
+TEST(GPMWebViewInstanceTableTest, RouterAnswersOnlyInstanceRequests) {
+    Plugin plugin(false);
+
+    Request closeClosed = { 3, CLOSE, 3, 0 };
+    Request toDefault = { Router::DEFAULT_INSTANCE_ID, SET_POSITION, 0, 1 };
+    Request toInstance = { 3, SET_POSITION, 3, 1 };
+    Request browser = { 3, SHOW_WEB_BROWSER, 3, 0 };
+    Request invalid = { INSTANCE_COUNT, SET_POSITION, 0, 1 };
+    plugin.handle(closeClosed);
+    plugin.handle(toDefault);
+    plugin.handle(invalid);
+    EXPECT_EQ(0u, plugin.callbacks.size());
+
+    plugin.handle(toInstance);
+    EXPECT_EQ(1u, plugin.countCallbacks(3, REQUEST_FAILED));
+
+    // Served without an open instance.
+    plugin.handle(browser);
+    EXPECT_EQ(1u, plugin.appRequestCount);
+    EXPECT_EQ(1u, plugin.callbacks.size());
+}
+
+TEST(GPMWebViewInstanceTableTest, StubViewKeepsGeometry) {
+    gpm::WebViewStubView<State> view;
+    gpm::WebViewStubView<State>::Geometry geometry;
+    geometry.hasSize = true;
+    geometry.width = 320;
+    geometry.height = 240;
+
+    ASSERT_TRUE(view.show(geometry));
+    EXPECT_FALSE(view.show(geometry));
+    EXPECT_EQ(1, view.state().isActive);
+    EXPECT_EQ(0, view.state().x);
+    EXPECT_EQ(320, view.state().width);
+
+    view.setMargins(10, 20);
+    view.setSize(100, 50);
+    EXPECT_EQ(10, view.state().x);
+    EXPECT_EQ(20, view.state().y);
+    EXPECT_EQ(100, view.state().width);
+    EXPECT_EQ(0, view.state().canGoBack);
+
+    EXPECT_TRUE(view.close());
+    EXPECT_FALSE(view.close());
+    EXPECT_EQ(0, view.state().isActive);
+    EXPECT_EQ(0, view.state().width);
+}
+
+// Run with GPM_NATIVE_TESTS_TSAN=ON to check the dispatch and state read paths for data races.
+TEST(GPMWebViewInstanceTableTest, SixteenInstancesThroughLanes) {
+    const int32_t positionCount = 200;
+    const int readerCount = 2;
+
+    Plugin plugin(false);
+    gpm::DispatchLanes<Request> lanes;
+    std::atomic<bool> done(false);
+    std::atomic<int> startedCount(0);
+    std::atomic<size_t> inconsistentReads(0);
+
+    // Other threads read the state and the table while requests are handled, as GetState and the sync getters do.
+    std::vector<std::thread> readers;
+    for(int reader = 0; reader < readerCount; reader++) {
+        readers.push_back(std::thread([&]() {
+            startedCount.fetch_add(1, std::memory_order_release);
+            while(done.load(std::memory_order_acquire) == false) {
+                for(long instanceId = 0; instanceId < INSTANCE_COUNT; instanceId++) {
+                    State state = plugin.states[instanceId].load();
+                    if(state.x != state.y || (state.isActive == 0 && state.x != 0)) {
+                        inconsistentReads.fetch_add(1, std::memory_order_relaxed);
+                    }
+                    Table::Entry entry;
+                    plugin.router.find(instanceId, entry);
+                }
+                std::this_thread::yield();
+            }
+        }));
+    }
+    while(startedCount.load(std::memory_order_acquire) < readerCount) {
+        std::this_thread::yield();
+    }
+
+    for(long instanceId = 0; instanceId < INSTANCE_COUNT; instanceId++) {
+        push(lanes, instanceId, SHOW, 0);
+    }
+    for(int32_t value = 1; value <= positionCount; value++) {
+        for(long instanceId = 0; instanceId < INSTANCE_COUNT; instanceId++) {
+            push(lanes, instanceId, SET_POSITION, value);
+        }
+    }
+    drain(lanes, plugin);
+
+    // Even instances close, then every instance gets one more request.
+    for(long instanceId = 0; instanceId < INSTANCE_COUNT; instanceId += 2) {
+        push(lanes, instanceId, CLOSE, 0);
+    }
+    for(long instanceId = 0; instanceId < INSTANCE_COUNT; instanceId++) {
+        push(lanes, instanceId, EXECUTE_JAVASCRIPT, 0);
+    }
+    drain(lanes, plugin);
+
+    done.store(true, std::memory_order_release);
+    for(size_t index = 0; index < readers.size(); index++) {
+        readers[index].join();
+    }
+
+    EXPECT_EQ(0u, inconsistentReads.load());
+    EXPECT_EQ((size_t)INSTANCE_COUNT / 2, plugin.router.openCount());
+    for(long instanceId = 0; instanceId < INSTANCE_COUNT; instanceId++) {
+        bool isOpen = instanceId % 2 != 0;
+        State state = plugin.states[instanceId].load();
+        EXPECT_EQ(1u, plugin.countCallbacks(instanceId, OPEN));
+        EXPECT_EQ(isOpen ? 0u : 1u, plugin.countCallbacks(instanceId, CLOSED));
+        // A request after the close is answered, not dropped, except on the default instance.
+        EXPECT_EQ(isOpen || instanceId == Router::DEFAULT_INSTANCE_ID ? 0u : 1u, plugin.countCallbacks(instanceId, REQUEST_FAILED));
+        EXPECT_EQ(isOpen ? 1 : 0, state.isActive);
+        EXPECT_EQ(isOpen ? positionCount : 0, state.x);
+
+        Table::Entry entry;
+        if(isOpen == true) {
+            ASSERT_TRUE(plugin.router.find(instanceId, entry));
+            EXPECT_EQ(1u, entry.backend->scriptCount);
+        }
+    }
+}
+
+TEST(GPMWebViewInstanceTableTest, SingleViewAnswersEveryOtherInstance) {
+    Plugin plugin(true);
+    gpm::DispatchLanes<Request> lanes;
+
+    for(long instanceId = 0; instanceId < INSTANCE_COUNT; instanceId++) {
+        push(lanes, instanceId, SHOW, 0);
+        push(lanes, instanceId, SET_POSITION, 7);
+    }
+    drain(lanes, plugin);
+
+    for(long instanceId = 0; instanceId < INSTANCE_COUNT; instanceId++) {
+        bool holdsView = instanceId == 0;
+        ASSERT_EQ(1u, plugin.countCallbacks(instanceId, OPEN));
+        EXPECT_EQ(holdsView ? 0u : 1u, plugin.countCallbacks(instanceId, REQUEST_FAILED));
+        EXPECT_EQ(holdsView ? 7 : 0, plugin.states[instanceId].load().x);
+    }
+    for(size_t index = 0; index < plugin.callbacks.size(); index++) {
+        const Callback& callback = plugin.callbacks[index];
+        if(callback.type == OPEN) {
+            // Refused shows get their own callback handle back with an error.
+            EXPECT_EQ(callback.instanceId, callback.callback);
+            EXPECT_EQ(callback.instanceId != 0, callback.hasError);
+        }
+    }
+}
+
+// Cost of handling a request, table lookup included, as the number of open instances grows.
+TEST(GPMWebViewInstanceTableTest, BenchmarkDispatchByInstanceCount) {
+    const int requestCount = 200000;
+    const long instanceCounts[] = { 1, 4, 16 };
+
+    for(size_t countIndex = 0; countIndex < sizeof(instanceCounts) / sizeof(instanceCounts[0]); countIndex++) {
+        long instanceCount = instanceCounts[countIndex];
+        Plugin plugin(false);
+        gpm::DispatchLanes<Request> lanes;
+
+        for(long instanceId = 0; instanceId < instanceCount; instanceId++) {
+            push(lanes, instanceId, SHOW, 0);
+        }
+        drain(lanes, plugin);
+
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        for(int request = 0; request < requestCount; request++) {
+            push(lanes, request % instanceCount, SET_POSITION, request);
+        }
+        drain(lanes, plugin);
+        std::chrono::nanoseconds elapsed = std::chrono::steady_clock::now() - start;
+
+        EXPECT_EQ((size_t)instanceCount, plugin.router.openCount());
+        EXPECT_EQ(requestCount - 1, plugin.states[(requestCount - 1) % instanceCount].load().x);
+        std::printf("dispatch with %ld instances : %.1f ns per request\n", instanceCount, (double)elapsed.count() / requestCount);
+    }
+}